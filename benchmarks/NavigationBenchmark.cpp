@@ -0,0 +1,126 @@
+// Flat A* vs hierarchical (HPA*) path queries on a large generated level.
+//
+// Usage: nav_benchmark [gridSize] [queryCount]
+// The level is a gridSize x gridSize field of platforms with random gaps, so paths have to
+// route around holes. Every query is run through NavigationGraph::findPath (flat A*), through
+// the hierarchy with full refinement, and through the hierarchy refining only the first
+// Config::NAV_REFINE_LOOKAHEAD segments, which is what an enemy pays when it repaths.
+
+#include "Systems/NavigationGraph.h"
+#include "Systems/HierarchicalPathfinder.h"
+#include "Entities/Platform.h"
+#include "Config.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr float PLATFORM_SPACING = 6.0f;
+constexpr float HOLE_CHANCE = 0.2f;
+
+float pathLength(const std::vector<glm::vec3>& path) {
+    float length = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        length += glm::distance(path[i - 1], path[i]);
+    }
+    return length;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+}
+
+int main(int argc, char** argv) {
+    int gridSize = argc > 1 ? std::atoi(argv[1]) : 150;
+    int queryCount = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (gridSize < 2 || queryCount < 1) {
+        std::fprintf(stderr, "usage: %s [gridSize >= 2] [queryCount >= 1]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<Platform> platforms;
+    for (int x = 0; x < gridSize; ++x) {
+        for (int z = 0; z < gridSize; ++z) {
+            if (unit(rng) < HOLE_CHANCE) continue;
+            glm::vec3 position(x * PLATFORM_SPACING, unit(rng) * 0.5f, z * PLATFORM_SPACING);
+            platforms.emplace_back(position, glm::vec3(4.0f, 1.0f, 4.0f));
+        }
+    }
+
+    NavigationGraph graph;
+    auto buildStart = std::chrono::steady_clock::now();
+    graph.buildFromPlatforms(platforms);
+    double buildMs = elapsedMs(buildStart);
+
+    std::printf("Level: %zu platforms, %zu nodes, %zu edges, graph built in %.1f ms\n",
+                platforms.size(), graph.getNodes().size(), graph.getEdges().size(), buildMs);
+
+    HierarchicalPathfinder hierarchy;
+    auto hierarchyStart = std::chrono::steady_clock::now();
+    hierarchy.build(graph, Config::NAV_CLUSTER_SIZE);
+    double hierarchyMs = elapsedMs(hierarchyStart);
+
+    std::printf("Hierarchy: %d clusters, %zu entrances, %zu abstract edges, built in %.1f ms\n",
+                hierarchy.getClusterCount(), hierarchy.getEntranceCount(),
+                hierarchy.getAbstractEdgeCount(), hierarchyMs);
+
+    float extent = (gridSize - 1) * PLATFORM_SPACING;
+    std::uniform_real_distribution<float> coordinate(0.0f, extent);
+    std::vector<std::pair<glm::vec3, glm::vec3>> queries;
+    for (int i = 0; i < queryCount; ++i) {
+        queries.push_back({glm::vec3(coordinate(rng), 0.0f, coordinate(rng)),
+                           glm::vec3(coordinate(rng), 0.0f, coordinate(rng))});
+    }
+
+    double flatMs = 0.0;
+    double fullMs = 0.0;
+    double lookaheadMs = 0.0;
+    int reachableMismatches = 0;
+    double flatLength = 0.0;
+    double hierarchicalLength = 0.0;
+
+    HierarchicalPathfinder::Path abstractPath;
+    std::vector<glm::vec3> partial;
+    for (const auto& [start, goal] : queries) {
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<glm::vec3> flat = graph.findPath(start, goal);
+        flatMs += elapsedMs(t0);
+
+        auto t1 = std::chrono::steady_clock::now();
+        std::vector<glm::vec3> full = hierarchy.findFullPath(start, goal);
+        fullMs += elapsedMs(t1);
+
+        auto t2 = std::chrono::steady_clock::now();
+        partial.clear();
+        if (hierarchy.findPath(start, goal, abstractPath)) {
+            hierarchy.refine(abstractPath, Config::NAV_REFINE_LOOKAHEAD, partial);
+        }
+        lookaheadMs += elapsedMs(t2);
+
+        if (flat.empty() != full.empty()) {
+            reachableMismatches++;
+        } else if (!flat.empty()) {
+            flatLength += pathLength(flat);
+            hierarchicalLength += pathLength(full);
+        }
+    }
+
+    std::printf("\n%-34s %12s\n", "Query", "avg ms");
+    std::printf("%-34s %12.4f\n", "Flat A*", flatMs / queryCount);
+    std::printf("%-34s %12.4f\n", "Hierarchical, fully refined", fullMs / queryCount);
+    std::printf("%-34s %12.4f\n", "Hierarchical, first segments only", lookaheadMs / queryCount);
+    std::printf("\nSpeedup (full / first segments): %.1fx / %.1fx\n",
+                flatMs / fullMs, flatMs / lookaheadMs);
+    if (flatLength > 0.0) {
+        std::printf("Hierarchical paths are %.1f%% longer than optimal on average\n",
+                    (hierarchicalLength / flatLength - 1.0) * 100.0);
+    }
+    std::printf("Reachability mismatches: %d\n", reachableMismatches);
+    return reachableMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// Particle update kernel: the old array-of-structs update (per-particle branch, std::remove_if
+// compaction, std::mt19937 + uniform_real_distribution for respawns) against ParticlePool's
+// SoA SSE2 update with swap-remove and FastRandom.
+//
+// Usage: particle_benchmark [particleCount] [frameCount]
+// Both sides start from the same particles and are topped back up to particleCount after
+// every frame, so each frame updates a full pool and replaces whatever expired.
+
+#include "Systems/FastRandom.h"
+#include "Systems/ParticlePool.h"
+#include "Config.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr float FRAME_TIME = 1.0f / 60.0f;
+constexpr float GRAVITY = 9.8f * 0.1f;
+
+// Layout and update of ParticleSystem before the SoA pool
+struct LegacyParticle {
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec4 color;
+    float life;
+    float initialLife;
+    float size;
+    float initialAlpha;
+};
+
+void legacyUpdate(std::vector<LegacyParticle>& particles, float deltaTime) {
+    for (auto& particle : particles) {
+        particle.life -= deltaTime;
+        if (particle.life > 0.0f) {
+            particle.position += particle.velocity * deltaTime;
+            particle.velocity.y -= GRAVITY * deltaTime;
+            if (particle.initialLife > 0.0001f) {
+                float lifeRatio = glm::clamp(particle.life / particle.initialLife, 0.0f, 1.0f);
+                particle.color.a = glm::clamp(particle.initialAlpha * lifeRatio, 0.0f, 1.0f);
+            } else {
+                particle.color.a = glm::clamp(particle.color.a - deltaTime, 0.0f, 1.0f);
+            }
+        }
+    }
+    particles.erase(std::remove_if(particles.begin(), particles.end(),
+                                   [](const LegacyParticle& p) { return p.life <= 0.0f; }),
+                    particles.end());
+}
+
+// Explosion-like spawn parameters, drawn through whichever generator is passed in
+template <typename RandomFn>
+void spawnParams(RandomFn&& random, glm::vec3& velocity, glm::vec4& color, float& life, float& size) {
+    float angle = random(0.0f, 6.28318f);
+    float speed = random(2.0f, 8.0f);
+    velocity = glm::vec3(std::cos(angle) * speed, random(2.0f, 6.0f), std::sin(angle) * speed);
+    color = glm::vec4(random(0.8f, 1.0f), random(0.3f, 0.6f), random(0.0f, 0.3f), 1.0f);
+    life = random(0.5f, 1.5f);
+    size = random(0.1f, 0.3f);
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+}
+
+int main(int argc, char** argv) {
+    int particleCount = argc > 1 ? std::atoi(argv[1]) : Config::MAX_PARTICLES;
+    int frameCount = argc > 2 ? std::atoi(argv[2]) : 600;
+    if (particleCount < 1 || frameCount < 1) {
+        std::fprintf(stderr, "usage: %s [particleCount >= 1] [frameCount >= 1]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 mt(1234);
+    auto mtRandom = [&](float min, float max) {
+        std::uniform_real_distribution<float> dist(min, max);
+        return dist(mt);
+    };
+    FastRandom fast(1234);
+    auto fastRandom = [&](float min, float max) { return fast.range(min, max); };
+
+    std::vector<LegacyParticle> legacy;
+    legacy.reserve(particleCount);
+    ParticlePool pool(static_cast<size_t>(particleCount));
+    for (int i = 0; i < particleCount; ++i) {
+        LegacyParticle p;
+        p.position = glm::vec3(0.0f);
+        spawnParams(mtRandom, p.velocity, p.color, p.life, p.size);
+        p.initialLife = p.life;
+        p.initialAlpha = p.color.a;
+        legacy.push_back(p);
+        pool.add(p.position, p.velocity, p.color, p.life, p.size, ParticleCategory::Impact);
+    }
+
+    double legacyUpdateMs = 0.0, legacySpawnMs = 0.0, poolUpdateMs = 0.0, poolSpawnMs = 0.0;
+    size_t legacyRespawned = 0, poolRespawned = 0;
+    for (int frame = 0; frame < frameCount; ++frame) {
+        auto start = std::chrono::steady_clock::now();
+        legacyUpdate(legacy, FRAME_TIME);
+        legacyUpdateMs += elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        while (legacy.size() < static_cast<size_t>(particleCount)) {
+            LegacyParticle p;
+            p.position = glm::vec3(0.0f);
+            spawnParams(mtRandom, p.velocity, p.color, p.life, p.size);
+            p.initialLife = p.life;
+            p.initialAlpha = p.color.a;
+            legacy.push_back(p);
+            legacyRespawned++;
+        }
+        legacySpawnMs += elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        pool.update(FRAME_TIME, GRAVITY);
+        poolUpdateMs += elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        while (pool.size() < pool.capacity()) {
+            glm::vec3 velocity;
+            glm::vec4 color;
+            float life, size;
+            spawnParams(fastRandom, velocity, color, life, size);
+            pool.add(glm::vec3(0.0f), velocity, color, life, size, ParticleCategory::Impact);
+            poolRespawned++;
+        }
+        poolSpawnMs += elapsedMs(start);
+    }
+
+    // Keep the optimizer from discarding the simulations
+    float checksum = 0.0f;
+    for (const LegacyParticle& p : legacy) checksum += p.position.y;
+    for (size_t i = 0; i < pool.size(); ++i) checksum += pool.getPositionY()[i];
+
+    std::printf("%d particles, %d frames (%zu / %zu respawned), checksum %.1f\n", particleCount, frameCount,
+                legacyRespawned, poolRespawned, checksum);
+    std::printf("%-34s %14s %14s\n", "Method", "update ms/frame", "spawn ms/frame");
+    std::printf("%-34s %14.4f %14.4f\n", "AoS + remove_if + mt19937", legacyUpdateMs / frameCount, legacySpawnMs / frameCount);
+    std::printf("%-34s %14.4f %14.4f\n", "SoA SSE2 + swap-remove + FastRandom", poolUpdateMs / frameCount, poolSpawnMs / frameCount);
+    std::printf("Update speedup: %.1fx, spawn speedup: %.1fx\n", legacyUpdateMs / poolUpdateMs, legacySpawnMs / poolSpawnMs);
+    return 0;
+}
@@ -0,0 +1,174 @@
+// Ray vs. triangle intersection on the shipped levels: the per-triangle routine over indexed
+// AoS vertex data (RaycastUtility::rayTriangleIntersection) against the SoA packet kernels,
+// both brute force and through TriangleBVH.
+//
+// Usage: ray_benchmark [rayCount] [level.glb ...]
+// Defaults to 20000 rays against assets/levels/level_1.glb. Meshes are pre-transformed into
+// one world-space soup per level; rays start inside the level bounds in random directions.
+
+#include "Systems/RaycastUtility.h"
+#include "Systems/TriangleBVH.h"
+#include "Systems/TrianglePacket.h"
+#include "Renderer/Mesh.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int BVH_REPEATS = 20; // BVH queries are fast enough to need several passes for stable timings
+
+struct LevelGeometry {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+};
+
+bool loadLevel(const std::string& path, LevelGeometry& out) {
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_PreTransformVertices);
+    if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)) {
+        return false;
+    }
+
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh* mesh = scene->mMeshes[m];
+        unsigned int base = static_cast<unsigned int>(out.vertices.size());
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            Vertex vertex{};
+            vertex.Position = glm::vec3(mesh->mVertices[v].x, mesh->mVertices[v].y, mesh->mVertices[v].z);
+            out.vertices.push_back(vertex);
+        }
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            if (mesh->mFaces[f].mNumIndices != 3) continue;
+            for (int k = 0; k < 3; ++k) {
+                out.indices.push_back(base + mesh->mFaces[f].mIndices[k]);
+            }
+        }
+    }
+    return !out.indices.empty();
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+}
+
+int main(int argc, char** argv) {
+    int rayCount = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (rayCount < 1) {
+        std::fprintf(stderr, "usage: %s [rayCount >= 1] [level.glb ...]\n", argv[0]);
+        return 1;
+    }
+    std::vector<std::string> levels;
+    for (int i = 2; i < argc; ++i) levels.push_back(argv[i]);
+    if (levels.empty()) levels.push_back("assets/levels/level_1.glb");
+
+    std::printf("Best supported kernel: %s\n", TriangleKernel::getName(TriangleKernel::getBestSupported()));
+
+    const TriangleKernel::Level kernels[] = {TriangleKernel::Level::Scalar, TriangleKernel::Level::SSE2,
+                                             TriangleKernel::Level::AVX2};
+    int mismatches = 0;
+
+    for (const std::string& path : levels) {
+        LevelGeometry level;
+        if (!loadLevel(path, level)) {
+            std::fprintf(stderr, "Could not load %s\n", path.c_str());
+            return 1;
+        }
+        size_t triangleCount = level.indices.size() / 3;
+
+        glm::vec3 boundsMin(level.vertices[0].Position), boundsMax(level.vertices[0].Position);
+        for (const Vertex& vertex : level.vertices) {
+            boundsMin = glm::min(boundsMin, vertex.Position);
+            boundsMax = glm::max(boundsMax, vertex.Position);
+        }
+        float maxT = glm::length(boundsMax - boundsMin);
+
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<glm::vec3> origins(rayCount), directions(rayCount);
+        for (int i = 0; i < rayCount; ++i) {
+            origins[i] = boundsMin + (boundsMax - boundsMin) * glm::vec3(unit(rng), unit(rng), unit(rng));
+            directions[i] = glm::vec3(unit(rng) - 0.5f, unit(rng) - 0.5f, unit(rng) - 0.5f);
+        }
+
+        // Reference: one triangle at a time, gathered through the index buffer
+        std::vector<float> reference(rayCount);
+        auto referenceStart = std::chrono::steady_clock::now();
+        for (int r = 0; r < rayCount; ++r) {
+            float closest = maxT;
+            bool hit = false;
+            for (size_t i = 0; i + 2 < level.indices.size(); i += 3) {
+                float t;
+                if (RaycastUtility::rayTriangleIntersection(origins[r], directions[r],
+                                                            level.vertices[level.indices[i]].Position,
+                                                            level.vertices[level.indices[i + 1]].Position,
+                                                            level.vertices[level.indices[i + 2]].Position, t) &&
+                    t <= closest) {
+                    closest = t;
+                    hit = true;
+                }
+            }
+            reference[r] = hit ? closest : -1.0f;
+        }
+        double referenceMs = elapsedMs(referenceStart);
+
+        std::vector<TrianglePacket> packets((triangleCount + TRIANGLE_PACKET_WIDTH - 1) / TRIANGLE_PACKET_WIDTH);
+        for (size_t i = 0; i < triangleCount; ++i) {
+            packets[i / TRIANGLE_PACKET_WIDTH].set(static_cast<int>(i % TRIANGLE_PACKET_WIDTH),
+                                                   level.vertices[level.indices[i * 3]].Position,
+                                                   level.vertices[level.indices[i * 3 + 1]].Position,
+                                                   level.vertices[level.indices[i * 3 + 2]].Position);
+        }
+
+        TriangleBVH bvh;
+        bvh.build(level.vertices, level.indices);
+
+        std::printf("\n%s: %zu triangles, %zu packets, %d rays\n", path.c_str(), triangleCount, packets.size(), rayCount);
+        std::printf("%-28s %12s %10s\n", "Method", "ms", "speedup");
+        std::printf("%-28s %12.3f %10s\n", "Per-triangle (AoS, indexed)", referenceMs, "1.0x");
+
+        for (TriangleKernel::Level kernel : kernels) {
+            if (static_cast<int>(kernel) > static_cast<int>(TriangleKernel::getBestSupported())) continue;
+            TriangleKernel::setActive(kernel);
+
+            auto packetStart = std::chrono::steady_clock::now();
+            for (int r = 0; r < rayCount; ++r) {
+                float closest = maxT;
+                bool hit = false;
+                for (const TrianglePacket& packet : packets) {
+                    float t;
+                    if (TriangleKernel::intersect(packet, origins[r], directions[r], closest, t) >= 0) {
+                        closest = t;
+                        hit = true;
+                    }
+                }
+                if ((hit ? closest : -1.0f) != reference[r]) mismatches++;
+            }
+            double packetMs = elapsedMs(packetStart);
+
+            auto bvhStart = std::chrono::steady_clock::now();
+            for (int repeat = 0; repeat < BVH_REPEATS; ++repeat) {
+                for (int r = 0; r < rayCount; ++r) {
+                    float t;
+                    bool hit = bvh.raycast(origins[r], directions[r], maxT, t);
+                    if (repeat == 0 && (hit ? t : -1.0f) != reference[r]) mismatches++;
+                }
+            }
+            double bvhMs = elapsedMs(bvhStart) / BVH_REPEATS;
+
+            std::string packetLabel = std::string("Packets, ") + TriangleKernel::getName(kernel);
+            std::string bvhLabel = std::string("BVH + packets, ") + TriangleKernel::getName(kernel);
+            std::printf("%-28s %12.3f %9.1fx\n", packetLabel.c_str(), packetMs, referenceMs / packetMs);
+            std::printf("%-28s %12.3f %9.1fx\n", bvhLabel.c_str(), bvhMs, referenceMs / bvhMs);
+        }
+    }
+
+    std::printf("\nMismatches against the per-triangle routine: %d\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -13,9 +13,47 @@ namespace Config {
     constexpr float PLAYER_ACCELERATION = 60.0f; // Fast acceleration
     constexpr float PLAYER_DECELERATION = 40.0f; // Quick stopping
     constexpr float FALL_DEATH_THRESHOLD = -20.0f; // Y position below which player dies
+    constexpr float BROADPHASE_MARGIN = 0.5f; // Padding around swept entity boxes when querying nearby platforms
+    constexpr float PROJECTILE_HIT_RADIUS = 1.0f; // Projectile hits anything whose center is this close to its path
+    constexpr float ENTITY_GRID_CELL_SIZE = 2.0f; // Spatial hash cell size for dynamic entities (enemies, player)
+
+    // Navigation graph
+    constexpr bool NAV_VALIDATE_EDGES = false; // Drop nav links that fail the step-height/line-of-sight check
+    constexpr float NAV_MAX_STEP_HEIGHT = 1.0f; // Largest height difference between linked platform tops
+    constexpr bool AI_USE_FLOW_FIELD = true; // Chasing enemies share one flow field toward the player instead of running A* each
+    constexpr int PATH_WORKER_THREADS = 2; // Background A* workers; 0 solves path requests on the main thread
+    constexpr float PATH_REQUEST_BUDGET_MS = 2.0f; // Path solving time allowed per frame
+    constexpr int NAV_HIERARCHY_MIN_NODES = 2000; // Graphs this large also get a cluster-level (HPA*) pathfinder
+    constexpr float NAV_CLUSTER_SIZE = 32.0f; // Edge length of the grid cells nav clusters are cut from
+    constexpr int NAV_REFINE_LOOKAHEAD = 2; // Abstract path segments refined ahead of an enemy
+    constexpr bool NAV_USE_NAVMESH = true; // Build the nav graph from a navmesh of the level triangles when the level has geometry
+    constexpr float NAV_CELL_SIZE = 0.3f; // Navmesh voxel size on the ground plane
+    constexpr float NAV_CELL_HEIGHT = 0.2f; // Navmesh voxel height
+    constexpr float NAV_MAX_SLOPE_DEGREES = 45.0f; // Steeper surfaces are not walkable
+    constexpr float AI_LOD_NEAR_DISTANCE = 25.0f; // Idle enemies closer than this still update every frame
+    constexpr float AI_LOD_FAR_DISTANCE = 60.0f; // Idle enemies beyond this drop to the far tier
+    constexpr int AI_LOD_MEDIUM_INTERVAL = 2; // Frames between updates for idle enemies between the two distances
+    constexpr int AI_LOD_FAR_INTERVAL = 6; // Frames between updates for far idle enemies
+    constexpr float ENEMY_SLEEP_DELAY = 0.5f; // Seconds an enemy must rest on the ground before its physics sleeps
     
     // Particle system
-    constexpr int MAX_PARTICLES = 2000;
+    constexpr int MAX_PARTICLES = 32768; // Pool capacity shared by every effect
+    // Per-category caps inside MAX_PARTICLES; a category over its cap replaces its own oldest particles
+    constexpr int PARTICLE_BUDGET_ATMOSPHERIC = 1024;
+    constexpr int PARTICLE_BUDGET_MUZZLE = 8192;
+    constexpr int PARTICLE_BUDGET_IMPACT = 16384;
+    constexpr int PARTICLE_BUDGET_SMOKE = 8192;
+    // Ranks from 0 up; when the pool is full, new particles evict the oldest of a lower-or-equal rank
+    constexpr int PARTICLE_PRIORITY_ATMOSPHERIC = 0;
+    constexpr int PARTICLE_PRIORITY_SMOKE = 1;
+    constexpr int PARTICLE_PRIORITY_IMPACT = 2;
+    constexpr int PARTICLE_PRIORITY_MUZZLE = 3;
+    constexpr float PARTICLE_LOD_NEAR_DISTANCE = 15.0f; // Effects closer than this emit their full count
+    constexpr float PARTICLE_LOD_FAR_DISTANCE = 60.0f;  // Beyond this they emit PARTICLE_LOD_MIN_SCALE of it
+    constexpr float PARTICLE_LOD_MIN_SCALE = 0.25f;
+
+    // Live projectile cap; check the pool high-water mark in the performance overlay before changing
+    constexpr int MAX_PROJECTILES = 512;
     
     // Player dimensions (realistic human proportions)
     constexpr float PLAYER_WIDTH = 0.6f;
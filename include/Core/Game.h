@@ -19,12 +19,17 @@ struct GLFWwindow;
 #include "Shader.h"
 #include "AudioSystem.h"
 #include "GuiSystem.h"
-#include "Projectile.h"
+#include "ProjectilePool.h"
 #include "Mesh.h"
 #include "NavigationGraph.h"
+#include "FlowField.h"
+#include "PathRequestService.h"
+#include "PerceptionSystem.h"
+#include "AILodScheduler.h"
 #include "PostProcessingSystem.h"
 #include "Skybox.h"
 #include "ShadowSystem.h"
+#include "AABBTree.h"
 
 class MenuSystem;
 class LevelManager;
@@ -51,6 +56,9 @@ public:
     bool initialize();
     void run();
     
+    // Offline step: build and write the next-hop table for every shipped level, then return
+    void bakeNavigationTables();
+    
     // Notification system
     void showNotification(const std::string& text, float duration = 5.0f);
     
@@ -65,6 +73,7 @@ private:
     void loadResources();
     void resetLevel();
     void loadLevel(int level);
+    void buildNavigation(int level);
     void loadSkybox(int level);
     void applySettings();
     void syncMusicWithState(bool forceRestart = false);
@@ -104,14 +113,20 @@ private:
     std::unique_ptr<HUD> hud;
     std::unique_ptr<DebugRenderer> debugRenderer;
     std::unique_ptr<NavigationGraph> navigationGraph;
+    FlowField playerFlowField; // Next-hop table toward the player's nav node, shared by chasing enemies
+    std::unique_ptr<PathRequestService> pathRequestService; // Declared after navigationGraph so workers stop first
+    std::vector<PathRequestService::PathResult> completedPaths; // Reused every frame
+    PerceptionSystem perception; // Per-tick enemy line of sight
+    AILodScheduler aiLod; // Which enemies update this frame
     std::unique_ptr<Skybox> skybox;
     std::unique_ptr<ShadowSystem> shadowSystem;
     WeaponRenderer weaponRenderer;
 
     std::vector<Platform> platforms;
+    AABBTree platformTree; // Broadphase over platform AABBs; payload is the index into `platforms`
     std::vector<Enemy> enemies;
     std::vector<WeaponPickup> weaponPickups;
-    std::vector<Projectile> projectiles;
+    ProjectilePool projectiles;
 
     InputState input;
 
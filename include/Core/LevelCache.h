@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class AABBTree;
+class NavigationGraph;
+class Platform;
+class TriangleBVH;
+
+// Binary sidecar (level_N.nav) holding everything derived from a level's geometry: the
+// per-platform world-space collision BVHs, the platform broadphase tree and the navigation graph with its
+// spatial index, navmesh and hierarchy. It is keyed by a content hash of the level's .glb and
+// by the Config values that shape the derived data, so editing either invalidates it.
+//
+// The whole file is read with a single read into memory; the restore* calls then copy each
+// section straight into the owning structures.
+class LevelCache {
+public:
+    // FNV-1a over the file contents; false if the file cannot be read
+    static bool hashFile(const std::string& path, uint64_t& outHash);
+
+    // Write a sidecar for the level currently in `platforms`, `broadphase` and `graph`
+    static bool save(const std::string& path, uint64_t sourceHash,
+                     const std::vector<Platform>& platforms,
+                     const AABBTree& broadphase,
+                     const NavigationGraph& graph);
+
+    // Read and validate a sidecar. False (and nothing kept) if it is missing, from another
+    // format version, or made from a different .glb or different settings.
+    bool load(const std::string& path, uint64_t sourceHash);
+    void clear();
+    bool isLoaded() const { return !m_data.empty(); }
+
+    // Each returns false if the section is missing or malformed; the caller then rebuilds
+    bool restoreCollisionBVHs(std::vector<TriangleBVH>& outBVHs) const;
+    // Every leaf payload must be a platform index below platformCount
+    bool restoreBroadphase(AABBTree& tree, size_t platformCount) const;
+    bool restoreNavigation(NavigationGraph& graph) const;
+
+    size_t getSizeBytes() const { return m_data.size(); }
+
+private:
+    static constexpr uint32_t FILE_MAGIC = 0x564C5342; // "BSLV"
+    static constexpr uint32_t FILE_VERSION = 2; // 2: collision BVHs per platform, in world space
+
+    // Section tags
+    static constexpr uint32_t SECTION_COLLISION_BVHS = 0x53485642; // "BVHS"
+    static constexpr uint32_t SECTION_BROADPHASE = 0x48505242; // "BRPH"
+    static constexpr uint32_t SECTION_NAVIGATION = 0x4756414E; // "NAVG"
+
+    struct Section {
+        uint32_t tag;
+        size_t offset;
+        size_t size;
+    };
+
+    std::vector<char> m_data;
+    std::vector<Section> m_sections;
+
+    // Hash of the Config values that change what gets built from the same .glb
+    static uint64_t settingsHash();
+    const Section* findSection(uint32_t tag) const;
+};
@@ -5,11 +5,14 @@
 #include <memory>
 #include <glm/glm.hpp>
 #include "Mesh.h"
+#include "LevelCache.h"
+#include "Systems/TriangleBVH.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
 class Game;
+class NavigationGraph;
 
 struct SceneObject {
     std::string name;
@@ -27,19 +30,36 @@ public:
 
     bool loadLevel(int levelIndex);
     bool levelExists(int levelIndex);
+    
+    // e.g. getLevelFilePath(2, ".glb") -> "assets/levels/level_2.glb"
+    static std::string getLevelFilePath(int levelIndex, const std::string& extension);
 
     const std::vector<std::unique_ptr<Mesh>>& getLevelMeshes() const { return m_levelMeshes; }
-    const std::vector<glm::mat4>& getLevelMeshTransforms() const { return m_levelMeshTransforms; }
+
+    // World-space triangles of all level collision geometry, three vertices per triangle
+    void getLevelTriangles(std::vector<glm::vec3>& outTriangles) const;
+
+    // Restore the navigation graph from the level's sidecar cache, if loadLevel found a valid one.
+    // Releases the cached file data either way.
+    bool restoreNavigation(NavigationGraph& graph);
+    // Write the sidecar cache for the current level (collision BVHs, broadphase and `graph`)
+    void saveLevelCache(const NavigationGraph& graph);
 
 private:
     void loadHardcodedFallback();
     void processNode(aiNode* node, const aiScene* scene, const glm::mat4& parentTransform);
     void handleObject(const SceneObject& obj, aiNode* node, const aiScene* scene, const glm::mat4& transform);
     void resolveSpawns();
+    void buildBroadphase();
 
     Game& m_game;
     std::string m_currentLevelPath;
+    std::string m_currentCachePath;
+    bool m_hasSourceHash = false;
+    uint64_t m_sourceHash = 0;   // Content hash of the current .glb
+    LevelCache m_levelCache;
+    std::vector<TriangleBVH> m_cachedBVHs; // Restored collision BVHs, consumed in platform order while processing nodes
+    size_t m_collisionMeshCount = 0;
     std::vector<std::unique_ptr<Mesh>> m_levelMeshes;
-    std::vector<glm::mat4> m_levelMeshTransforms;
     std::vector<SceneObject> m_pendingSpawns;
 };
@@ -38,6 +38,7 @@ struct GraphicSettings {
     bool gammaCorrection = true;
     float techStyleIntensity = 0.6f; // 0.0 = off, 1.0 = full tech effect
     bool showFPS = false;
+    bool gpuParticles = false; // Compute-shader particle simulation; falls back to the CPU if unsupported
 
     // Post-processing
     bool bloomEnabled = true;
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include "Entities/Weapon.h"
+#include "Systems/HierarchicalPathfinder.h"
 
 class NavigationGraph;
+class FlowField;
+class PathRequestService;
 class Platform;
+class AABBTree;
 class AudioSystem; // Forward declaration for optional audio callback
 
 
@@ -15,11 +20,20 @@ public:
     
     // Update enemy AI and behavior
     // ... rest of header ...
-    void update(float deltaTime, glm::vec3 playerPosition, 
+    // playerInSight is this tick's line-of-sight result from the PerceptionSystem
+    void update(float deltaTime, glm::vec3 playerPosition, bool playerInSight,
                 const NavigationGraph* navGraph,
+                const FlowField* flowField,
+                PathRequestService* pathService,
+                int pathRequesterId,
                 const std::vector<Platform>& platforms,
+                const AABBTree* platformTree,
                 AudioSystem* audio = nullptr);
 
+    // Delivery of an asynchronous path; ignored unless it answers the latest request.
+    // route is the unrefined remainder of a hierarchical path (finished for full paths).
+    void onPathReady(uint32_t ticket, std::vector<glm::vec3>&& path, HierarchicalPathfinder::Path&& route);
+
     // Alert state accessors
     bool isAlerted() const;
     float getAlertProgress() const; // 1.0 -> just alerted, 0.0 -> faded
@@ -41,8 +55,18 @@ public:
     glm::vec3 getLookDirection() const { return lookDirection; }
     glm::vec3 getVelocity() const { return velocity; }
     bool isOnGround() const { return onGround; }
+    float getDetectionRange() const { return detectionRange; }
+    bool isTrackingPlayer() const { return hasSeenPlayer; } // Chasing the player or their last seen position
     Weapon* getWeapon() const { return weapon.get(); }
     
+    // Physics sleep: a grounded enemy at rest skips integration until it wants to move,
+    // takes damage or wake() is called (e.g. when geometry around it changes)
+    bool isSleeping() const { return sleeping; }
+    void wake();
+    
+    // Set by the AI level-of-detail scheduler for enemies on a reduced tier
+    void setSimplifiedPhysics(bool simplified) { simplifiedPhysics = simplified; }
+    
     // Weapon dropping
     bool isWeaponDropped() const { return m_weaponDropped; }
     void setWeaponDropped(bool dropped) { m_weaponDropped = dropped; }
@@ -84,12 +108,20 @@ private:
     int currentWaypointIndex;
     float pathRecalculateTimer;
     float pathRecalculateInterval;
+    uint32_t pendingPathTicket; // 0 when no request is outstanding
+    HierarchicalPathfinder::Path abstractPath; // Cluster route still being refined into currentPath
+    bool simplifiedPhysics;
+    bool sleeping;
+    float restTime; // Seconds spent grounded and motionless
+    std::vector<int> nearbyPlatforms; // Broadphase scratch, reused every frame
     
     // Helper methods
-    void updateMovement(float deltaTime, glm::vec3 playerPosition,
+    void updateMovement(float deltaTime, glm::vec3 playerPosition, bool hasLOS,
                        const NavigationGraph* navGraph,
-                       const std::vector<Platform>& platforms);
+                       const FlowField* flowField,
+                       PathRequestService* pathService,
+                       int pathRequesterId);
     void followPath(float deltaTime);
-    void applyPhysics(float deltaTime, const std::vector<Platform>& platforms);
-    bool checkLineOfSight(glm::vec3 playerPosition, const std::vector<Platform>& platforms) const;
+    void followFlowField(const NavigationGraph* navGraph, const FlowField* flowField, glm::vec3 target);
+    void applyPhysics(float deltaTime, const std::vector<Platform>& platforms, const AABBTree* platformTree);
 };
@@ -3,11 +3,13 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
+#include "Systems/CollisionMesh.h"
 
 class Mesh;
 
 class Platform {
 public:
+    // A mesh passed here must still hold its CPU data; collision is cooked from it
     Platform(glm::vec3 position, glm::vec3 size, const Mesh* mesh = nullptr, const glm::mat4& transform = glm::mat4(1.0f), const std::string& name = "Platform");
     
     // Check collision with player - modifies player position to resolve penetration
@@ -24,6 +26,11 @@ public:
     // Perform a raycast against this platform, returns distance to hit or -1.0f if no hit
     float raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
     
+    // Attach a mesh for rendering only; collision uses the cooked mesh below
+    void addMesh(const Mesh* mesh);
+    // Attach world-space collision geometry; enables the narrow phase for this platform
+    void setCollisionMesh(CollisionMesh&& collisionMesh);
+
     // Getters
     glm::vec3 getPosition() const { return position; }
     glm::vec3 getSize() const { return size; }
@@ -31,13 +38,16 @@ public:
     bool isFloor() const { return m_isFloor; }
     bool hasMesh() const { return !m_meshes.empty(); }
     const std::vector<const Mesh*>& getMeshes() const { return m_meshes; }
-    std::vector<const Mesh*>& getMeshes() { return m_meshes; }
+    bool hasCollisionMesh() const { return m_hasCollisionMesh; }
+    const CollisionMesh& getCollisionMesh() const { return m_collisionMesh; }
     const glm::mat4& getTransform() const { return m_transform; }
 
 private:
     glm::vec3 position;
     glm::vec3 size;
     std::vector<const Mesh*> m_meshes;
+    CollisionMesh m_collisionMesh; // World space, covers all of m_meshes
+    bool m_hasCollisionMesh = false;
     glm::mat4 m_transform;
     std::string m_name;
     bool m_isFloor;
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "Projectile.h"
+
+// Fixed-capacity storage for live projectiles.
+// Memory is reserved once, so spawning never reallocates; despawning swaps the
+// last live projectile into the freed slot, keeping [begin, end) dense.
+// Iteration order is therefore not spawn order.
+class ProjectilePool {
+public:
+    using iterator = std::vector<Projectile>::iterator;
+    using const_iterator = std::vector<Projectile>::const_iterator;
+
+    explicit ProjectilePool(size_t capacity);
+
+    // Returns nullptr (and counts a drop) when the pool is full
+    Projectile* spawn(glm::vec3 position, glm::vec3 direction, float speed, float damage, float lifetime, bool isEnemy = false);
+
+    // Swap-and-pop. Returns an iterator to the element now occupying the freed slot (end()
+    // if the last element was removed), so removal loops should not advance after calling this.
+    iterator despawn(iterator it);
+
+    void clear() { m_projectiles.clear(); }
+
+    iterator begin() { return m_projectiles.begin(); }
+    iterator end() { return m_projectiles.end(); }
+    const_iterator begin() const { return m_projectiles.begin(); }
+    const_iterator end() const { return m_projectiles.end(); }
+
+    size_t size() const { return m_projectiles.size(); }
+    bool empty() const { return m_projectiles.empty(); }
+    size_t capacity() const { return m_capacity; }
+
+    // Most projectiles alive at once since startup; use it to size MAX_PROJECTILES
+    size_t getHighWaterMark() const { return m_highWaterMark; }
+    // Spawns rejected because the pool was full
+    size_t getDroppedCount() const { return m_droppedCount; }
+
+private:
+    std::vector<Projectile> m_projectiles;
+    size_t m_capacity;
+    size_t m_highWaterMark;
+    size_t m_droppedCount;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include <glad/gl.h>
 #include <glm/glm.hpp>
@@ -10,19 +11,56 @@ struct Vertex {
     glm::vec2 TexCoords;
 };
 
+// Who a mesh belongs to, for the resident memory report
+enum class MeshCategory {
+    Level,     // Level geometry from LevelManager
+    Weapon,    // Weapon models from ModelLoader::loadModel
+    Primitive, // Procedural shapes from GeometryFactory
+    Count
+};
+
+// What happens to the vertex/index vectors once they are on the GPU
+enum class MeshCpuData {
+    Release, // Freed right after upload; the mesh can only be drawn
+    Keep     // Kept for collision cooking or other readback until releaseCpuData()
+};
+
 class Mesh {
 public:
+    struct MemoryStats {
+        size_t meshCount = 0;
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+    };
+
+    // Empty unless the mesh was created with MeshCpuData::Keep
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
     unsigned int VAO;
-    
-    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices);
+
+    // Takes the vectors by value; pass them with std::move to avoid a copy
+    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices,
+         MeshCategory category, MeshCpuData cpuData = MeshCpuData::Release);
     ~Mesh();
-    
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
     void draw() const;
-    
+
+    // Free the CPU copy once nothing needs to read it anymore
+    void releaseCpuData();
+    bool hasCpuData() const { return !vertices.empty() || !indices.empty(); }
+
+    // Totals over all live meshes of a category
+    static MemoryStats getMemoryStats(MeshCategory category);
+
 private:
     unsigned int VBO, EBO;
-    
+    unsigned int indexCount;
+    MeshCategory category;
+    size_t cpuBytes;
+    size_t gpuBytes;
+
     void setupMesh();
 };
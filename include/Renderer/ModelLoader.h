@@ -10,8 +10,11 @@
 
 class ModelLoader {
 public:
-    static std::vector<std::unique_ptr<Mesh>> loadModel(const std::string& path);
-    static std::unique_ptr<Mesh> processMesh(aiMesh* mesh, const aiScene* scene);
+    // Draw-only meshes: the CPU copies are released after upload
+    static std::vector<std::unique_ptr<Mesh>> loadModel(const std::string& path, MeshCategory category);
+    static std::unique_ptr<Mesh> processMesh(aiMesh* mesh, const aiScene* scene, MeshCategory category,
+                                             MeshCpuData cpuData = MeshCpuData::Release);
 private:
-    static void processNode(aiNode* node, const aiScene* scene, std::vector<std::unique_ptr<Mesh>>& meshes);
+    static void processNode(aiNode* node, const aiScene* scene, MeshCategory category,
+                            std::vector<std::unique_ptr<Mesh>>& meshes);
 };
@@ -9,13 +9,18 @@ public:
     unsigned int ID;
     
     Shader(const char* vertexPath, const char* fragmentPath);
+    // Compute program (GL 4.3+)
+    explicit Shader(const char* computePath);
     ~Shader();
     
     void use() const;
+    // False if any stage failed to compile or the program failed to link
+    bool isLinked() const { return linked; }
     
     // Utility uniform functions
     void setBool(const std::string& name, bool value) const;
     void setInt(const std::string& name, int value) const;
+    void setUInt(const std::string& name, unsigned int value) const;
     void setFloat(const std::string& name, float value) const;
     void setVec3(const std::string& name, const glm::vec3& value) const;
     void setVec3(const std::string& name, float x, float y, float z) const;
@@ -23,5 +28,8 @@ public:
     void setMat4(const std::string& name, const glm::mat4& mat) const;
     
 private:
+    bool linked = false;
+
+    static std::string readFile(const char* path);
     void checkCompileErrors(unsigned int shader, std::string type);
 };
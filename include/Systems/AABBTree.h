@@ -0,0 +1,134 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include "Systems/RaycastUtility.h"
+
+// Dynamic AABB tree used as the scene-wide broadphase.
+// Each proxy stores a fattened box and an integer payload (e.g. a platform index).
+// Inserts pick the sibling with the lowest surface-area cost and the tree is kept
+// balanced with rotations, so queries stay O(log n) as proxies come and go.
+class AABBTree {
+public:
+    explicit AABBTree(float margin = 0.1f);
+
+    // Insert a box; returns a proxy id that stays valid until destroyProxy/clear
+    int createProxy(const glm::vec3& boundsMin, const glm::vec3& boundsMax, int userData);
+    void destroyProxy(int proxyId);
+
+    // Update a proxy's box. Only reinserts when the new box leaves the fattened one.
+    // Returns true if the tree changed.
+    bool moveProxy(int proxyId, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    void clear();
+
+    int getUserData(int proxyId) const { return m_nodes[proxyId].userData; }
+    int getProxyCount() const { return m_proxyCount; }
+    int getHeight() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+    bool empty() const { return m_root == NULL_NODE; }
+
+    // Bounds of everything in the tree (fattened). Only meaningful when not empty.
+    glm::vec3 getBoundsMin() const { return m_nodes[m_root].boundsMin; }
+    glm::vec3 getBoundsMax() const { return m_nodes[m_root].boundsMax; }
+
+    // Calls callback(userData) for every proxy overlapping the box.
+    // Return false from the callback to stop early.
+    template <typename Callback>
+    void query(const glm::vec3& boundsMin, const glm::vec3& boundsMax, Callback&& callback) const;
+
+    // Calls callback(userData, maxDistance) for every proxy whose box the ray enters before maxDistance.
+    // The callback returns the new clip distance (return the input to keep going, 0 to stop).
+    template <typename Callback>
+    void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const;
+
+    // Fills `out` with the payloads of all proxies overlapping the box, sorted ascending
+    void queryUserData(const glm::vec3& boundsMin, const glm::vec3& boundsMax, std::vector<int>& out) const;
+
+private:
+    friend class LevelCache;
+
+    static constexpr int NULL_NODE = -1;
+    // Rotations keep the height near 1.44 * log2(n), so a fixed traversal stack is plenty
+    static constexpr int MAX_STACK = 128;
+
+    struct Node {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        int parent;  // Doubles as the free-list link for unused nodes
+        int child1;
+        int child2;
+        int height;  // Leaf = 0, free = -1
+        int userData;
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    std::vector<Node> m_nodes;
+    int m_root;
+    int m_freeList;
+    int m_proxyCount;
+    float m_margin;
+
+    int allocateNode();
+    void freeNode(int nodeId);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int nodeId);
+
+    static bool overlaps(const Node& node, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+        return node.boundsMin.x <= boundsMax.x && node.boundsMax.x >= boundsMin.x &&
+               node.boundsMin.y <= boundsMax.y && node.boundsMax.y >= boundsMin.y &&
+               node.boundsMin.z <= boundsMax.z && node.boundsMax.z >= boundsMin.z;
+    }
+};
+
+template <typename Callback>
+void AABBTree::query(const glm::vec3& boundsMin, const glm::vec3& boundsMax, Callback&& callback) const {
+    if (m_root == NULL_NODE) return;
+
+    int stack[MAX_STACK];
+    int stackSize = 0;
+    stack[stackSize++] = m_root;
+
+    while (stackSize > 0) {
+        int nodeId = stack[--stackSize];
+
+        const Node& node = m_nodes[nodeId];
+        if (!overlaps(node, boundsMin, boundsMax)) continue;
+
+        if (node.isLeaf()) {
+            if (!callback(node.userData)) return;
+        } else {
+            stack[stackSize++] = node.child1;
+            stack[stackSize++] = node.child2;
+        }
+    }
+}
+
+template <typename Callback>
+void AABBTree::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const {
+    if (m_root == NULL_NODE) return;
+
+    int stack[MAX_STACK];
+    int stackSize = 0;
+    stack[stackSize++] = m_root;
+
+    while (stackSize > 0) {
+        int nodeId = stack[--stackSize];
+
+        const Node& node = m_nodes[nodeId];
+        float tMin, tMax;
+        if (!RaycastUtility::rayAABBIntersection(origin, direction, node.boundsMin, node.boundsMax, tMin, tMax) ||
+            tMin > maxDistance) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            maxDistance = callback(node.userData, maxDistance);
+            if (maxDistance <= 0.0f) return;
+        } else {
+            stack[stackSize++] = node.child1;
+            stack[stackSize++] = node.child2;
+        }
+    }
+}
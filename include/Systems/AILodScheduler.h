@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Enemy;
+class PerceptionSystem;
+
+// Distance/visibility based level of detail for enemy AI.
+// Enemies that are engaged (tracking the player, or able to see them last tick) or idle within
+// Config::AI_LOD_NEAR_DISTANCE update every frame. Idle enemies further out update every
+// AI_LOD_MEDIUM_INTERVAL or AI_LOD_FAR_INTERVAL frames, offset by their index so the work is
+// spread round-robin over frames, and get the time they skipped when they do run.
+class AILodScheduler {
+public:
+    enum class Tier {
+        Full,
+        Medium,
+        Far,
+        Count
+    };
+
+    AILodScheduler();
+
+    // Assign tiers for this frame and decide which enemies run. `perception` still holds
+    // last tick's results at this point.
+    void update(const std::vector<Enemy>& enemies, const glm::vec3& playerPosition,
+                const PerceptionSystem& perception, float deltaTime);
+
+    // Forget accumulated time and tiers (call when the enemy list is recreated)
+    void clear();
+
+    bool shouldUpdate(size_t enemyIndex) const { return enemyIndex < m_active.size() && m_active[enemyIndex] != 0; }
+    Tier getTier(size_t enemyIndex) const { return m_tiers[enemyIndex]; }
+
+    // Time since the enemy last ran, including this frame; resets the enemy's accumulator
+    float consumeDeltaTime(size_t enemyIndex);
+
+    // 1 for enemies that run this frame, indexed like the enemy list
+    const std::vector<uint8_t>& getActiveMask() const { return m_active; }
+
+    // Stats for the last update
+    int getEnemyCount(Tier tier) const { return m_enemyCounts[static_cast<int>(tier)]; }
+    int getUpdatedCount(Tier tier) const { return m_updatedCounts[static_cast<int>(tier)]; }
+
+private:
+    uint32_t m_frame;
+    std::vector<Tier> m_tiers;
+    std::vector<uint8_t> m_active;
+    std::vector<float> m_pendingTime;
+    int m_enemyCounts[static_cast<int>(Tier::Count)];
+    int m_updatedCounts[static_cast<int>(Tier::Count)];
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include "Systems/TriangleBVH.h"
+
+struct Vertex;
+
+// Collision geometry of one platform, cooked once at level load and kept apart from the
+// render meshes. Triangles are stored pre-transformed to world space in a single BVH, so
+// queries take world-space rays directly and never read vertex data owned by the renderer.
+class CollisionMesh {
+public:
+    CollisionMesh() = default;
+    // Wrap a BVH that was already cooked (e.g. restored from the level cache)
+    explicit CollisionMesh(TriangleBVH&& bvh);
+
+    // Queue the triangles of an indexed mesh, transformed to world space.
+    // Degenerate triangles (zero area, non-finite corners, bad indices) are dropped here.
+    void addTriangles(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                      const glm::mat4& transform);
+    // Build the BVH over everything queued so far and release the staging copy
+    void cook();
+
+    // Closest hit along origin + direction * t with t in (0, maxT]. Direction should be normalized.
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, float& outT) const {
+        return m_bvh.raycast(origin, direction, maxT, outT);
+    }
+    bool raycastAny(const glm::vec3& origin, const glm::vec3& direction, float maxT) const {
+        return m_bvh.raycastAny(origin, direction, maxT);
+    }
+
+    bool empty() const { return m_bvh.empty(); }
+    const TriangleBVH& getBVH() const { return m_bvh; }
+    size_t getTriangleCount() const { return m_bvh.getTriangleCount(); }
+    size_t getDroppedCount() const { return m_droppedCount; }
+
+private:
+    // Below this cross-product length the ray kernel's determinant test rejects every hit anyway
+    static constexpr float DEGENERATE_AREA_EPSILON = 1e-7f;
+
+    std::vector<TriangleBVH::Triangle> m_staging;
+    TriangleBVH m_bvh;
+    size_t m_droppedCount = 0;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// Counter-based generator (SplitMix64). Every value is a pure hash of the seed plus the draw
+// index, so consecutive draws do not depend on each other's output and a loop over
+// valueAt(i) vectorizes. Not for anything that needs statistical rigour beyond visual effects.
+class FastRandom {
+public:
+    explicit FastRandom(uint64_t seed) : m_seed(seed), m_counter(0) {}
+
+    // Uniform in [0, 1)
+    float nextFloat() { return valueAt(m_counter++); }
+    float range(float min, float max) { return min + (max - min) * nextFloat(); }
+
+    // The value the index-th draw of this generator returns, without advancing it
+    float valueAt(uint64_t index) const {
+        uint64_t z = m_seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        // Top 24 bits fill a float mantissa exactly
+        return static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+    }
+
+private:
+    uint64_t m_seed;
+    uint64_t m_counter;
+};
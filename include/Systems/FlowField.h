@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+class NavigationGraph;
+
+// Shared "which way to the target" table over the navigation graph.
+// One Dijkstra pass from the target's nav node fills a next-hop entry for every
+// node, so any number of agents chasing that target can look up their next
+// waypoint in O(1). The field is only rebuilt when the target moves to a
+// different nav node.
+class FlowField {
+public:
+    FlowField();
+
+    // Rebuild if the target's closest nav node changed. Returns true if the field was recomputed.
+    bool update(const NavigationGraph& graph, const glm::vec3& target);
+
+    // Forget the current field (call after the navigation graph is rebuilt)
+    void invalidate();
+
+    bool isValid() const { return targetNode != -1; }
+    int getTargetNode() const { return targetNode; }
+
+    // Next node on the shortest path from `node` to the target; -1 if unreachable (or node is the target)
+    int getNextNode(int node) const;
+    float getCostToTarget(int node) const;
+
+    int getRebuildCount() const { return rebuildCount; }
+
+private:
+    int targetNode;
+    int rebuildCount;
+    std::vector<int> nextHop;
+    std::vector<float> costToTarget;
+};
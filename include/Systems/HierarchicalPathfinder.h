@@ -0,0 +1,72 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class NavigationGraph;
+
+// Two-level (HPA*-style) pathfinding over a NavigationGraph.
+// Nodes are grouped into clusters (connected pieces of a coarse spatial grid). A few edges along
+// each cluster border are picked as transitions and their end nodes become entrances; the
+// abstract graph links entrances across those transitions and, inside a cluster, with the
+// precomputed cluster-local shortest path cost. A query searches
+// the small abstract graph, and the concrete waypoints are filled in segment by segment only
+// when the caller asks for them.
+class HierarchicalPathfinder {
+public:
+    // Result of an abstract query. Segments between consecutive waypoints are refined lazily.
+    struct Path {
+        std::vector<int> waypoints; // Graph nodes: start, entrances..., goal
+        glm::vec3 goal{0.0f};
+        size_t nextSegment = 0;     // Next waypoints[i] -> waypoints[i + 1] pair to refine
+        bool finished = true;       // Every segment (and the final goal position) has been emitted
+
+        void clear() { waypoints.clear(); nextSegment = 0; finished = true; }
+    };
+
+    HierarchicalPathfinder() = default;
+
+    // The graph must outlive the pathfinder and must not change after build()
+    void build(const NavigationGraph& graph, float clusterSize);
+    void clear();
+    bool isBuilt() const { return m_graph != nullptr; }
+
+    // Abstract search from the node closest to start to the node closest to goal
+    bool findPath(const glm::vec3& start, const glm::vec3& goal, Path& outPath) const;
+
+    // Append the concrete positions for the next `segments` abstract segments to `waypoints`.
+    // The first call also emits the start node; the call that finishes the path appends the goal.
+    // Returns false once there was nothing left to refine.
+    bool refine(Path& path, int segments, std::vector<glm::vec3>& waypoints) const;
+
+    // Convenience: abstract search plus full refinement (matches NavigationGraph::findPath output)
+    std::vector<glm::vec3> findFullPath(const glm::vec3& start, const glm::vec3& goal) const;
+
+    int getClusterCount() const { return m_clusterCount; }
+    size_t getEntranceCount() const { return m_entranceNodes.size(); }
+    size_t getAbstractEdgeCount() const { return m_abstractTargets.size(); }
+
+private:
+    friend class LevelCache;
+
+    // A border between two clusters gets one transition, plus one more per this many crossing edges
+    static constexpr size_t EDGES_PER_TRANSITION = 8;
+
+    const NavigationGraph* m_graph = nullptr;
+    int m_clusterCount = 0;
+
+    std::vector<int> m_clusterOf;       // Graph node -> cluster
+    std::vector<int> m_abstractIndex;   // Graph node -> entrance index, -1 if not an entrance
+    std::vector<int> m_entranceNodes;   // Entrance index -> graph node
+    std::vector<int> m_clusterEntranceOffsets; // CSR: entrances of cluster c are
+    std::vector<int> m_clusterEntrances;        // m_clusterEntrances[offsets[c] .. offsets[c + 1])
+
+    // Abstract graph over entrances in CSR form
+    std::vector<int> m_abstractOffsets;
+    std::vector<int> m_abstractTargets;
+    std::vector<float> m_abstractCosts;
+
+    // Dijkstra limited to one cluster; fills (entrance index, cost) for every entrance reached
+    void costsToEntrances(int sourceNode, std::vector<std::pair<int, float>>& out) const;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Static 3D k-d tree over a point set, stored implicitly: the median of each
+// range is its subtree root, so no node structs or pointers are needed.
+// Build is O(n log n); nearest-neighbour queries are O(log n) on average.
+// Results are indices into the point array passed to build().
+class KDTree {
+public:
+    KDTree() = default;
+
+    void build(const std::vector<glm::vec3>& points);
+    void clear();
+
+    bool empty() const { return m_indices.empty(); }
+    size_t size() const { return m_indices.size(); }
+
+    // Index of the closest point, or -1 when empty
+    int nearest(const glm::vec3& position) const;
+
+    // Up to k closest points, nearest first
+    void kNearest(const glm::vec3& position, size_t k, std::vector<int>& out) const;
+
+    // All points within radius (inclusive), nearest first
+    void withinRadius(const glm::vec3& position, float radius, std::vector<int>& out) const;
+
+private:
+    friend class LevelCache;
+
+    std::vector<glm::vec3> m_points;  // Reordered into tree order
+    std::vector<int> m_indices;       // Tree slot -> original point index
+    std::vector<uint8_t> m_splitAxis; // Split axis of the subtree rooted at each slot
+
+    void buildRange(const std::vector<glm::vec3>& points, int begin, int end);
+
+    void nearestRange(int begin, int end, const glm::vec3& position, int& bestSlot, float& bestDistSq) const;
+    // Max-heap of (distSq, slot) capped at k entries
+    void kNearestRange(int begin, int end, const glm::vec3& position, size_t k, std::vector<std::pair<float, int>>& heap) const;
+    void radiusRange(int begin, int end, const glm::vec3& position, float radiusSq, std::vector<std::pair<float, int>>& found) const;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// Walkable surface generated from raw level triangles.
+// The triangles are voxelized into a heightfield of solid spans; span tops with enough headroom
+// and a gentle enough slope become walkable cells, cells are linked to neighbours the agent can
+// step to, the walkable area is eroded by the agent radius and the remaining cells are merged
+// into convex (rectangular) polygons. Polygons sharing an edge are connected through a portal,
+// and paths through a polygon corridor are straightened with the funnel algorithm.
+class NavMesh {
+public:
+    struct Settings {
+        float cellSize;        // Horizontal voxel size
+        float cellHeight;      // Vertical voxel size
+        float agentHeight;     // Minimum headroom above a walkable cell
+        float agentRadius;     // Walkable area is shrunk by this much away from edges and walls
+        float maxStepHeight;   // Largest height change between neighbouring cells
+        float maxSlopeDegrees; // Steeper triangles are never walkable
+        int maxPolygonCells;   // Longest polygon side, in cells
+        int threadCount;       // 0 picks std::thread::hardware_concurrency()
+    };
+
+    struct Polygon {
+        glm::vec2 min;     // XZ extent
+        glm::vec2 max;
+        float minY;        // Surface height range over the polygon
+        float maxY;
+        glm::vec3 center;
+    };
+
+    // Shared edge between two polygons, oriented for travel from the owning polygon into `neighbor`
+    struct Portal {
+        int neighbor;
+        glm::vec3 left;
+        glm::vec3 right;
+    };
+
+    // Agent dimensions and step height from Config
+    static Settings defaultSettings();
+
+    // triangles holds three world-space vertices per triangle
+    void build(const std::vector<glm::vec3>& triangles, const Settings& settings);
+    void clear();
+    bool empty() const { return m_polygons.empty(); }
+
+    const std::vector<Polygon>& getPolygons() const { return m_polygons; }
+    int getPortalBegin(int polygon) const { return m_portalOffsets[polygon]; }
+    int getPortalEnd(int polygon) const { return m_portalOffsets[polygon + 1]; }
+    const Portal& getPortal(int slot) const { return m_portals[slot]; }
+
+    // Polygon under a position (the highest one not more than a step above it), -1 if none
+    int findPolygon(const glm::vec3& position) const;
+
+    // Straighten a path through consecutive polygons. Returns the corner points after start,
+    // ending with goal.
+    std::vector<glm::vec3> stringPull(const glm::vec3& start, const glm::vec3& goal,
+                                      const std::vector<int>& polygonPath) const;
+
+    // Stats from the last build
+    float getLastBuildTimeMs() const { return m_lastBuildTimeMs; }
+    size_t getWalkableCellCount() const { return m_walkableCellCount; }
+
+private:
+    friend class LevelCache;
+
+    // Columns beyond this make the heightfield too large; the cell size is raised to fit
+    static constexpr size_t MAX_GRID_COLUMNS = 4 * 1024 * 1024;
+
+    std::vector<Polygon> m_polygons;
+    std::vector<int> m_portalOffsets; // CSR: portals of polygon p are [offsets[p], offsets[p + 1])
+    std::vector<Portal> m_portals;
+    float m_maxStepHeight = 0.0f;
+
+    // Uniform bucket grid over polygon XZ bounds for findPolygon
+    glm::vec2 m_bucketOrigin{0.0f};
+    float m_bucketSize = 1.0f;
+    int m_bucketsX = 0;
+    int m_bucketsZ = 0;
+    std::vector<int> m_bucketOffsets;
+    std::vector<int> m_bucketPolygons;
+
+    float m_lastBuildTimeMs = 0.0f;
+    size_t m_walkableCellCount = 0;
+
+    void buildPolygonIndex();
+};
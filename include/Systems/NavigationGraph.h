@@ -1,10 +1,20 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
+#include "Systems/HierarchicalPathfinder.h"
+#include "Systems/KDTree.h"
+#include "Systems/NavMesh.h"
+#include "Systems/NextHopTable.h"
 
 class Platform;
+class AABBTree;
 
 struct NavNode {
     glm::vec3 position;
@@ -27,15 +37,51 @@ class NavigationGraph {
 public:
     NavigationGraph();
     
-    // Build the navigation graph from platforms
-    void buildFromPlatforms(const std::vector<Platform>& platforms);
+    // Build the navigation graph from platforms.
+    // With validateEdges, candidate links are dropped unless the step between platform tops is
+    // small enough and there is line of sight between them (checked on worker threads).
+    void buildFromPlatforms(const std::vector<Platform>& platforms,
+                            const AABBTree* broadphase = nullptr,
+                            bool validateEdges = false);
+    
+    // Build the graph from a navmesh: one node per polygon, one edge pair per shared portal.
+    // The graph keeps the mesh, so findPath string-pulls through the polygons it crosses.
+    void buildFromNavMesh(NavMesh&& mesh);
     
     // Find path using A* algorithm
     std::vector<glm::vec3> findPath(const glm::vec3& start, const glm::vec3& goal) const;
     
-    // Get the closest node to a position
+    // A* between two nodes; returns node positions from start to goal, empty if unreachable.
+    // Safe to call from several threads at once.
+    std::vector<glm::vec3> findNodePath(int startNode, int goalNode) const;
+    
+    // Same search, as node indices from start to goal; false if unreachable
+    bool findNodeSequence(int startNode, int goalNode, std::vector<int>& outNodes) const;
+    
+    // Waypoints for walking a node sequence from start to goal: the node positions, or on a
+    // navmesh the string-pulled corners, followed by goal
+    std::vector<glm::vec3> buildWaypoints(const glm::vec3& start, const glm::vec3& goal,
+                                          const std::vector<int>& nodeSequence) const;
+    
+    // A* that only expands nodes for which allowed(node) returns true (start and goal must pass).
+    // Replaces outNodes with the node indices from start to goal; false if unreachable.
+    template <typename Filter>
+    bool findNodePathWithin(int startNode, int goalNode, Filter&& allowed, std::vector<int>& outNodes) const;
+    
+    // Get the closest node to a position (on a navmesh, the polygon under it if there is one)
     int getClosestNode(const glm::vec3& position) const;
     
+    // Up to k closest nodes, nearest first
+    std::vector<int> getClosestNodes(const glm::vec3& position, size_t k) const;
+    
+    // All nodes within radius of a position, nearest first
+    std::vector<int> getNodesInRadius(const glm::vec3& position, float radius) const;
+    
+    // Single-source Dijkstra outward from targetNode. Fills, for every node, the next node on its
+    // shortest path to the target (-1 for the target itself and unreachable nodes) and the cost to get there.
+    // Relies on every edge having a reverse twin of equal cost, which buildFromPlatforms guarantees.
+    void computeFlowField(int targetNode, std::vector<int>& nextHop, std::vector<float>& costToTarget) const;
+    
     // Check if graph is valid
     bool isValid() const { return !nodes.empty(); }
     
@@ -45,15 +91,139 @@ public:
     // Get all edges (for debug visualization)
     const std::vector<NavEdge>& getEdges() const { return edges; }
     
+    // Outgoing edges of a node, as a range of edge slots [getEdgeBegin, getEdgeEnd)
+    int getEdgeBegin(int node) const { return adjacencyOffsets[node]; }
+    int getEdgeEnd(int node) const { return adjacencyOffsets[node + 1]; }
+    int getEdgeTarget(int edgeSlot) const { return adjacencyTargets[edgeSlot]; }
+    float getEdgeCost(int edgeSlot) const { return adjacencyCosts[edgeSlot]; }
+    
+    // Precomputed all-pairs routing. While a table is loaded, findPath/findNodePath walk it
+    // instead of running A*. Rebuilding the graph drops the table.
+    bool bakeNextHopTable();
+    bool saveNextHopTable(const std::string& path) const;
+    bool loadNextHopTable(const std::string& path);
+    bool hasNextHopTable() const { return !nextHopTable.empty(); }
+    const NextHopTable& getNextHopTable() const { return nextHopTable; }
+    
+    // Cluster-level pathfinder, built by buildFromPlatforms for graphs of at least
+    // Config::NAV_HIERARCHY_MIN_NODES nodes. Rebuilding the graph rebuilds or drops it.
+    bool hasNavMesh() const { return !navMesh.empty(); }
+    const NavMesh& getNavMesh() const { return navMesh; }
+    
+    bool hasHierarchy() const { return hierarchy.isBuilt(); }
+    const HierarchicalPathfinder& getHierarchy() const { return hierarchy; }
+    
+    // Hash of node positions and edges; identifies the graph a baked table belongs to
+    uint64_t computeSignature() const;
+    
+    // Stats from the last buildFromPlatforms call
+    float getLastBuildTimeMs() const { return lastBuildTimeMs; }
+    int getRejectedEdgeCount() const { return rejectedEdgeCount; }
+    
 private:
+    friend class LevelCache;
+
     std::vector<NavNode> nodes;
     std::vector<NavEdge> edges;
     
+    // Compressed sparse row adjacency built from `edges`:
+    // the outgoing edges of node n are [adjacencyOffsets[n], adjacencyOffsets[n + 1])
+    std::vector<int> adjacencyOffsets;
+    std::vector<int> adjacencyTargets;
+    std::vector<float> adjacencyCosts;
+    
+    // Spatial index over node positions for nearest-node lookups
+    KDTree nodeIndex;
+    
+    NextHopTable nextHopTable;
+    NavMesh navMesh;
+    HierarchicalPathfinder hierarchy;
+    
+    float lastBuildTimeMs = 0.0f;
+    int rejectedEdgeCount = 0;
+    
+    // Per-thread A* scratch. Entries whose generation differs from the current search are
+    // treated as unvisited, so nothing has to be cleared between searches.
+    struct SearchScratch {
+        std::vector<float> gScore;
+        std::vector<int> cameFrom;
+        std::vector<uint32_t> generation;
+        std::vector<std::pair<float, int>> openHeap;
+        uint32_t currentGeneration = 0;
+        
+        void begin(size_t nodeCount);
+        bool visited(int node) const { return generation[node] == currentGeneration; }
+    };
+    static SearchScratch& getSearchScratch();
+    
     // Maximum distance for walkable connections
     static constexpr float MAX_WALK_DISTANCE = 8.0f;
+    // Below this many candidate edges per thread, validation stays on the calling thread
+    static constexpr size_t MIN_EDGES_PER_THREAD = 256;
     
     // A* helper functions
-    float heuristic(const glm::vec3& a, const glm::vec3& b) const;
+    float heuristic(const glm::vec3& a, const glm::vec3& b) const { return glm::distance(a, b); }
     std::vector<int> getNeighbors(int nodeIndex) const;
-    std::vector<glm::vec3> reconstructPath(const std::vector<int>& cameFrom, int current) const;
+    void buildAdjacency();
+    bool walkNextHopTable(int startNode, int goalNode, std::vector<int>& outNodes) const;
+    void reset();
+    void finishBuild(std::chrono::steady_clock::time_point buildStart);
+    void validateCandidateEdges(const std::vector<Platform>& platforms,
+                                const AABBTree* broadphase,
+                                const std::vector<std::pair<int, int>>& candidates,
+                                std::vector<char>& keep) const;
 };
+
+template <typename Filter>
+bool NavigationGraph::findNodePathWithin(int startNode, int goalNode, Filter&& allowed, std::vector<int>& outNodes) const {
+    outNodes.clear();
+    
+    // A* over the CSR adjacency with flat, generation-stamped score arrays
+    SearchScratch& scratch = getSearchScratch();
+    scratch.begin(nodes.size());
+    auto& openHeap = scratch.openHeap;
+    const auto compare = std::greater<std::pair<float, int>>();
+    const glm::vec3 goalPosition = nodes[goalNode].position;
+    
+    scratch.generation[startNode] = scratch.currentGeneration;
+    scratch.gScore[startNode] = 0.0f;
+    scratch.cameFrom[startNode] = -1;
+    openHeap.push_back({heuristic(nodes[startNode].position, goalPosition), startNode});
+    
+    while (!openHeap.empty()) {
+        std::pop_heap(openHeap.begin(), openHeap.end(), compare);
+        auto [fScore, current] = openHeap.back();
+        openHeap.pop_back();
+        
+        if (current == goalNode) {
+            for (int node = current; node != -1; node = scratch.cameFrom[node]) {
+                outNodes.push_back(node);
+            }
+            std::reverse(outNodes.begin(), outNodes.end());
+            return true;
+        }
+        
+        // Skip stale heap entries left behind by a later, cheaper push
+        float currentG = scratch.gScore[current];
+        if (fScore > currentG + heuristic(nodes[current].position, goalPosition)) {
+            continue;
+        }
+        
+        for (int e = adjacencyOffsets[current]; e < adjacencyOffsets[current + 1]; ++e) {
+            int neighbor = adjacencyTargets[e];
+            if (!allowed(neighbor)) continue;
+            float tentativeGScore = currentG + adjacencyCosts[e];
+            
+            if (!scratch.visited(neighbor) || tentativeGScore < scratch.gScore[neighbor]) {
+                scratch.generation[neighbor] = scratch.currentGeneration;
+                scratch.cameFrom[neighbor] = current;
+                scratch.gScore[neighbor] = tentativeGScore;
+                openHeap.push_back({tentativeGScore + heuristic(nodes[neighbor].position, goalPosition), neighbor});
+                std::push_heap(openHeap.begin(), openHeap.end(), compare);
+            }
+        }
+    }
+    
+    // No path found
+    return false;
+}
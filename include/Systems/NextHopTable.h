@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class NavigationGraph;
+
+// All-pairs routing table for a static navigation graph.
+// For every (from, to) node pair it stores the next node to step to and the
+// remaining path cost, both as 16-bit values, so a few thousand nodes cost
+// tens of megabytes and a path query is just a walk through the table.
+// Baked offline and stored next to the level file; see NavigationGraph::loadNextHopTable.
+class NextHopTable {
+public:
+    static constexpr uint16_t NO_NODE = 0xFFFF;
+    static constexpr size_t MAX_NODES = 0xFFFF; // NO_NODE is reserved
+
+    // One Dijkstra per target node, split across threads. Fails for graphs over MAX_NODES.
+    bool build(const NavigationGraph& graph);
+
+    // graphSignature ties the file to the graph it was baked from; load() rejects mismatches
+    bool save(const std::string& path, uint64_t graphSignature) const;
+    bool load(const std::string& path, uint64_t graphSignature);
+
+    void clear();
+    bool empty() const { return m_nodeCount == 0; }
+    size_t getNodeCount() const { return m_nodeCount; }
+    size_t getMemoryBytes() const { return (m_nextHop.size() + m_distance.size()) * sizeof(uint16_t); }
+
+    // -1 when unreachable or from == to
+    int getNextHop(int from, int to) const {
+        uint16_t next = m_nextHop[static_cast<size_t>(from) * m_nodeCount + to];
+        return next == NO_NODE ? -1 : next;
+    }
+    // Approximate (quantized) path cost; infinity when unreachable
+    float getDistance(int from, int to) const;
+
+private:
+    static constexpr uint32_t FILE_MAGIC = 0x484E5342; // "BSNH"
+    static constexpr uint32_t FILE_VERSION = 1;
+    static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+    size_t m_nodeCount = 0;
+    float m_distanceScale = 0.0f;    // World units per quantization step
+    std::vector<uint16_t> m_nextHop; // Row-major [from * n + to]
+    std::vector<uint16_t> m_distance;
+};
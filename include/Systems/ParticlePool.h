@@ -0,0 +1,75 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What emitted a particle; budgets and eviction priority are per category
+enum class ParticleCategory : uint8_t {
+    Atmospheric,
+    Muzzle,
+    Impact,
+    Smoke,
+    Count
+};
+
+// Fixed-capacity particle storage in structure-of-arrays form: index i of every array is one
+// particle and [0, size()) is always dense. update() integrates and fades four particles per
+// SSE2 step with no per-particle branches, and dead particles are removed by moving the last
+// live one into their slot. Each category's particles are also linked oldest to newest, so
+// evicting the oldest never has to search the pool.
+// No GL state lives here; ParticleSystem owns a pool and handles uploads and drawing.
+class ParticlePool {
+public:
+    explicit ParticlePool(size_t capacity);
+
+    // Returns false (and adds nothing) when the pool is full
+    bool add(const glm::vec3& position, const glm::vec3& velocity, const glm::vec4& color, float life, float size,
+             ParticleCategory category);
+    // Remove up to `count` of the category's oldest particles; returns how many went
+    size_t evictOldest(ParticleCategory category, size_t count);
+
+    // Integrate velocity and gravity, fade alpha with remaining life and drop expired particles
+    void update(float deltaTime, float gravity);
+    void clear();
+
+    size_t size() const { return m_count; }
+    size_t getCount(ParticleCategory category) const { return m_categoryCounts[static_cast<int>(category)]; }
+    size_t capacity() const { return m_capacity; }
+
+    // Attribute arrays, valid for indices [0, size())
+    const float* getPositionX() const { return m_posX.data(); }
+    const float* getPositionY() const { return m_posY.data(); }
+    const float* getPositionZ() const { return m_posZ.data(); }
+    const float* getColorR() const { return m_colorR.data(); }
+    const float* getColorG() const { return m_colorG.data(); }
+    const float* getColorB() const { return m_colorB.data(); }
+    const float* getAlpha() const { return m_alpha.data(); }
+    const float* getSize() const { return m_size.data(); }
+    const float* getLife() const { return m_life.data(); }
+
+private:
+    static constexpr int32_t NO_PARTICLE = -1;
+    static constexpr int CATEGORY_COUNT = static_cast<int>(ParticleCategory::Count);
+
+    void removeAt(size_t index);
+    void unlink(size_t index);
+
+    size_t m_capacity;
+    size_t m_count;
+    size_t m_categoryCounts[CATEGORY_COUNT];
+    int32_t m_oldest[CATEGORY_COUNT]; // Ends of each category's age list
+    int32_t m_newest[CATEGORY_COUNT];
+
+    std::vector<float> m_posX, m_posY, m_posZ;
+    std::vector<float> m_velX, m_velY, m_velZ;
+    std::vector<float> m_colorR, m_colorG, m_colorB, m_alpha;
+    std::vector<float> m_life;
+    std::vector<float> m_invInitialLife; // 1 / life at emission, so fading is a multiply
+    std::vector<float> m_initialAlpha;
+    std::vector<float> m_size;
+    std::vector<uint8_t> m_category;
+    std::vector<int32_t> m_older; // Age-list neighbours within the same category
+    std::vector<int32_t> m_newer;
+};
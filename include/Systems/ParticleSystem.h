@@ -2,21 +2,13 @@
 
 #include <glad/gl.h>
 #include <glm/glm.hpp>
+#include <memory>
 #include <vector>
-#include <random>
+#include "Systems/FastRandom.h"
+#include "Systems/ParticlePool.h"
 
 class Shader;
 
-struct Particle {
-    glm::vec3 position;
-    glm::vec3 velocity;
-    glm::vec4 color;
-    float life;
-    float initialLife;   // store initial life for smooth fading
-    float size;
-    float initialAlpha;  // store initial alpha for fading
-};
-
 enum ParticleType {
     EXPLOSION,
     FIRE,
@@ -43,23 +35,94 @@ public:
     void enableAtmospheric(bool enabled);
     void setAtmosphereRate(int particlesPerSecond);
     void setAtmosphereRadius(float radius);
+    // Generate the dust in the vertex shader (particle_atmosphere.vert) instead of spawning pooled
+    // particles: no CPU work, upload or pool slots, just one instanced draw of moteCount quads
+    void setAtmosphereProcedural(bool enabled);
+    void setAtmosphereMoteCount(int moteCount);
     
-    // Get particles for rendering
-    const std::vector<Particle>& getParticles() const; 
+    // Simulate with compute shaders instead of the CPU pool. Needs SSBO access from vertex
+    // shaders; otherwise the CPU path stays active. Switching discards live particles.
+    // Returns whether the requested mode is now active.
+    bool setGpuSimulation(bool enabled);
+    bool isGpuSimulation() const { return gpuSimulation; }
+
+    // On the GPU path this is the number of ring slots in use, live or expired
+    size_t getParticleCount() const { return gpuSimulation ? ringSlotsUsed : particles.size(); }
+
+    // Budget accounting per category, since construction. Budgets and eviction only apply to the
+    // CPU pool; the GPU ring always overwrites its oldest slots.
+    struct CategoryStats {
+        uint64_t emitted = 0;
+        uint64_t dropped = 0; // Refused: no room and nothing of lower or equal priority to evict
+        uint64_t evicted = 0; // Live particles removed early to make room for newer ones
+        uint64_t culled = 0;  // Skipped by distance-based emission reduction
+    };
+    const CategoryStats& getCategoryStats(ParticleCategory category) const {
+        return categoryStats[static_cast<int>(category)];
+    }
+    size_t getParticleCount(ParticleCategory category) const { return particles.getCount(category); }
     
 private:
-    std::vector<Particle> particles;
+    // Per-instance vertex data, matches the attributes in particle.vert
+    struct ParticleInstance {
+        glm::vec4 positionSize; // xyz = position, w = size
+        glm::vec4 color;
+    };
+
+    ParticlePool particles;
     int maxParticles;
     unsigned int VAO, VBO;
-    std::mt19937 rng;
+    unsigned int instanceVBO;                     // Orphaned and refilled every frame
+    std::vector<ParticleInstance> instanceData;  // Staging for instanceVBO, reused every frame
+
+    // std430 layout shared with particle_emit.comp, particle_update.comp and particle_gpu.vert
+    struct GpuParticle {
+        glm::vec4 positionSize; // xyz = position, w = size
+        glm::vec4 velocityLife; // xyz = velocity, w = remaining life
+        glm::vec4 color;
+        glm::vec4 fade;         // x = 1 / initial life, y = initial alpha
+    };
+
+    // GPU simulation: emissions are queued here, appended to the ring once per update
+    bool gpuSimulation = false;
+    bool gpuInitialized = false;
+    unsigned int ringSSBO = 0;      // maxParticles GpuParticles, simulated in place
+    unsigned int emitSSBO = 0;      // This frame's emission requests
+    unsigned int ringHead = 0;      // Next slot an emission overwrites
+    unsigned int ringSlotsUsed = 0; // Slots written at least once; dispatches and draws cover only these
+    std::vector<GpuParticle> gpuEmitQueue;
+    std::unique_ptr<Shader> emitShader;
+    std::unique_ptr<Shader> updateShader;
+    std::unique_ptr<Shader> gpuRenderShader;
+    FastRandom rng;
     
     // Atmospheric particle settings
     bool atmosphereEnabled = false;
     int atmosphereRate = 8; // particles per second
     float atmosphereRadius = 25.0f;
     float atmosphereAccumulator = 0.0f;
+    bool atmosphereProcedural = false;
+    int atmosphereMoteCount = 300;
+    float atmosphereTime = 0.0f;        // Drives the procedural motes
+    glm::vec3 viewCenter{0.0f};         // Last center passed to update(); dust and emission LOD are relative to it
+    std::unique_ptr<Shader> atmosphereShader;
+
+    CategoryStats categoryStats[static_cast<int>(ParticleCategory::Count)];
+
+    static constexpr float GRAVITY = 9.8f * 0.1f; // Reduced gravity effect for small particles
+    static constexpr unsigned int COMPUTE_GROUP_SIZE = 64; // local_size_x of the particle compute shaders
+    static constexpr float ATMOSPHERE_PERIOD = 420.0f; // ANIMATION_PERIOD in particle_atmosphere.vert
 
     void setupBuffers();
-    void emitParticle(glm::vec3 position, glm::vec3 velocity, glm::vec4 color, float life, float size);
+    bool initGpu();
+    void releaseGpu();
+    void simulateGpu(float deltaTime);
+    void drawGpu(const glm::mat4& projection, const glm::mat4& view);
+    void drawAtmosphere(const glm::mat4& projection, const glm::mat4& view);
+    // Reduce a burst's count with the emitter's distance from viewCenter
+    int scaleEmission(ParticleCategory category, const glm::vec3& position, int count);
+    // Apply the category's budget and evict as needed; returns how many particles may be emitted
+    int reserve(ParticleCategory category, int count);
+    void emitParticle(ParticleCategory category, glm::vec3 position, glm::vec3 velocity, glm::vec4 color, float life, float size);
     float randomFloat(float min, float max);
 };
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Systems/HierarchicalPathfinder.h"
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class NavigationGraph;
+
+// Queues path requests and solves them off the main thread.
+// Requests that map to the same (start node, goal node) pair while still queued are
+// merged into one search. Solving is time-sliced: each frame the workers may spend
+// at most the budget passed to update() (summed over all workers; a search that has
+// already started is allowed to finish). Results are collected with takeCompleted().
+class PathRequestService {
+public:
+    enum class RequestType {
+        Full,        // Complete waypoint list from NavigationGraph
+        Hierarchical // Cluster route; only the first few segments come back refined
+    };
+
+    struct PathResult {
+        int requesterId;
+        uint32_t ticket;
+        std::vector<glm::vec3> path;
+        HierarchicalPathfinder::Path abstractPath; // Hierarchical requests: the rest of the route to refine
+    };
+
+    // workerCount 0 solves requests on the main thread inside update()
+    explicit PathRequestService(int workerCount);
+    ~PathRequestService();
+
+    PathRequestService(const PathRequestService&) = delete;
+    PathRequestService& operator=(const PathRequestService&) = delete;
+
+    // Drops every queued, in-flight and completed request and waits for workers to
+    // leave the old graph. Call before the graph is rebuilt (with nullptr) and again after.
+    void setGraph(const NavigationGraph* graph);
+
+    // Returns a ticket identifying this request (never 0), or 0 if there is no graph.
+    // Hierarchical requests fall back to Full on a graph without a hierarchy.
+    uint32_t request(int requesterId, const glm::vec3& start, const glm::vec3& goal,
+                     RequestType type = RequestType::Full);
+
+    // Once per frame on the main thread: opens a new time slice of budgetMs
+    void update(float budgetMs);
+
+    // Moves finished results into `out` (replacing its contents)
+    void takeCompleted(std::vector<PathResult>& out);
+
+    // Stats
+    size_t getQueuedCount() const;
+    uint64_t getMergedRequestCount() const;
+    uint64_t getSolvedCount() const;
+
+private:
+    struct Waiter {
+        int requesterId;
+        uint32_t ticket;
+        glm::vec3 start;
+        glm::vec3 goal;
+    };
+
+    struct Job {
+        RequestType type;
+        int startNode;
+        int goalNode;
+        std::vector<Waiter> waiters;
+    };
+
+    // Node indices are non-negative, so the top bit is free to keep the two request types apart
+    static uint64_t makeKey(RequestType type, int startNode, int goalNode) {
+        uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(startNode)) << 32) | static_cast<uint32_t>(goalNode);
+        return type == RequestType::Hierarchical ? key | (1ULL << 63) : key;
+    }
+
+    void workerLoop();
+    // Runs one job; called without the lock held
+    void solve(const NavigationGraph* graph, Job& job, std::vector<PathResult>& results) const;
+    bool canStartJob() const { return !m_order.empty() && m_frameSpentMs < m_frameBudgetMs; }
+
+    const NavigationGraph* m_graph;
+    std::vector<std::thread> m_workers;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_idle;
+
+    std::unordered_map<uint64_t, Job> m_pending; // Queued jobs by node pair
+    std::deque<uint64_t> m_order;                // FIFO of keys into m_pending
+    std::vector<PathResult> m_completed;
+
+    uint32_t m_nextTicket;
+    uint32_t m_generation; // Bumped by setGraph so in-flight results from an old graph are discarded
+    int m_inFlight;
+    bool m_stopping;
+
+    float m_frameBudgetMs;
+    float m_frameSpentMs;
+
+    uint64_t m_mergedCount;
+    uint64_t m_solvedCount;
+};
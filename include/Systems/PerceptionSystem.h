@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "Systems/RaycastUtility.h"
+
+class Enemy;
+class Platform;
+class AABBTree;
+
+// Enemy-to-player line of sight, tested once per tick for every enemy that can use it.
+// Enemy::update, its movement logic and the debug overlay all read the memoized result
+// instead of casting their own rays against the level.
+class PerceptionSystem {
+public:
+    PerceptionSystem();
+
+    // Test every alive enemy that is within detection range or still tracking the player.
+    // Results are indexed like `enemies` and stay valid until the next update. With an
+    // activeMask only enemies marked 1 are retested; the rest keep their previous result.
+    void update(const std::vector<Enemy>& enemies, const glm::vec3& playerPosition,
+                const std::vector<Platform>& platforms, const AABBTree* platformTree,
+                const std::vector<uint8_t>* activeMask = nullptr);
+
+    // Forget all results (call when the enemy list is recreated)
+    void clear();
+
+    // Clear view from the enemy's eye to the player's eye this tick. False for enemies
+    // that were not tested (dead, or idle and out of range).
+    bool hasLineOfSight(size_t enemyIndex) const {
+        return enemyIndex < m_lineOfSight.size() && m_lineOfSight[enemyIndex] != 0;
+    }
+
+    // Stats for the last update
+    int getRayCount() const { return m_rayCount; }
+    int getSkippedCount() const { return m_skippedCount; }
+
+private:
+    std::vector<uint8_t> m_lineOfSight;
+
+    // Batch scratch, reused every tick
+    std::vector<RaycastUtility::Segment> m_segments;
+    std::vector<size_t> m_segmentEnemies;
+    std::vector<uint8_t> m_blocked;
+    int m_rayCount;
+    int m_skippedCount;
+};
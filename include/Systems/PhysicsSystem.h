@@ -8,6 +8,8 @@
 #include "Projectile.h"
 #include "WeaponPickup.h"
 #include "ParticleSystem.h"
+#include "SpatialHashGrid.h"
+#include "RaycastUtility.h"
 
 class Game;
 
@@ -22,7 +24,16 @@ private:
     void updatePlayerPhysics(float deltaTime);
     void updateProjectiles(float deltaTime);
     void handleCollisions();
+    void rebuildEntityGrid();
+
+    // Payloads stored in m_entityGrid: enemy index, or one of these
+    static constexpr int PLAYER_ENTITY = -1;
+    static constexpr int NO_ENTITY = -2;
 
     Game& m_game;
     float m_deathTimer;
+    std::vector<int> m_nearbyPlatforms; // Broadphase scratch, reused every frame
+    SpatialHashGrid m_entityGrid;       // Enemies + player, rebuilt every tick for projectile sweeps
+    std::vector<RaycastUtility::Ray> m_projectileRays; // Level sweep batch, reused every frame
+    std::vector<RaycastUtility::RaycastHit> m_projectileLevelHits;
 };
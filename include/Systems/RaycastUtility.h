@@ -1,10 +1,12 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 
 class Platform;
 class Mesh;
+class AABBTree;
 
 class RaycastUtility {
 public:
@@ -17,20 +19,55 @@ public:
         
         RaycastHit() : hit(false), point(0.0f), distance(0.0f), platformIndex(-1) {}
     };
+
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction; // Need not be normalized
+        float maxDistance;
+    };
+
+    struct Segment {
+        glm::vec3 start;
+        glm::vec3 end;
+    };
     
     // Cast a ray and check for platform intersection
+    // When a broadphase is given only platforms whose AABB the ray enters are tested
     static RaycastHit raycastPlatforms(
         const glm::vec3& origin,
         const glm::vec3& direction,
         float maxDistance,
-        const std::vector<Platform>& platforms
+        const std::vector<Platform>& platforms,
+        const AABBTree* broadphase = nullptr
     );
     
     // Check if line of sight is clear between two points
     static bool hasLineOfSight(
         const glm::vec3& from,
         const glm::vec3& to,
-        const std::vector<Platform>& platforms
+        const std::vector<Platform>& platforms,
+        const AABBTree* broadphase = nullptr
+    );
+
+    // Batched queries. Rays are sorted by direction octant and origin cell, grouped into
+    // packets that share one broadphase query over the packet's bounds, and large batches
+    // are split across threads. Results are indexed like the input.
+
+    // Nearest hit for every ray (same result as raycastPlatforms per ray)
+    static void raycastPlatformsBatch(
+        const std::vector<Ray>& rays,
+        std::vector<RaycastHit>& outHits,
+        const std::vector<Platform>& platforms,
+        const AABBTree* broadphase = nullptr
+    );
+
+    // outHit[i] is 1 if anything blocks segments[i]; stops at the first blocker, so it is
+    // cheaper than a nearest-hit query. Used for line of sight.
+    static void segmentsHitPlatformsBatch(
+        const std::vector<Segment>& segments,
+        std::vector<uint8_t>& outHit,
+        const std::vector<Platform>& platforms,
+        const AABBTree* broadphase = nullptr
     );
     
 public:
@@ -53,4 +90,14 @@ public:
         const glm::vec3& v2,
         float& t
     );
+
+    // Segment-sphere intersection. t is the fraction along start -> end of the first contact
+    // (0 when the segment starts inside the sphere).
+    static bool segmentSphereIntersection(
+        const glm::vec3& start,
+        const glm::vec3& end,
+        const glm::vec3& center,
+        float radius,
+        float& t
+    );
 };
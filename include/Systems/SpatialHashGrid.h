@@ -0,0 +1,127 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Uniform grid over hashed cells for small, fast-moving dynamic entities (enemies, the player).
+// Rebuilt from scratch every tick: insert() everything, build(), then run segment queries.
+// Each entity is a sphere and is registered in every cell its bounding box touches, so a
+// segment only has to visit the cells it passes through to find every sphere it could hit.
+class SpatialHashGrid {
+public:
+    struct Item {
+        glm::vec3 center;
+        float radius;
+        int userData;
+    };
+
+    // bucketCount is rounded up to a power of two
+    explicit SpatialHashGrid(float cellSize = 2.0f, int bucketCount = 1024);
+
+    void clear();
+    void insert(int userData, const glm::vec3& center, float radius);
+    // Sort the inserted items into buckets; call once after the last insert
+    void build();
+
+    // Calls callback(item) once for every item whose cells the segment start -> end passes through.
+    // Candidates are conservative (hash collisions included); the caller does the exact test.
+    // Return false from the callback to stop early.
+    template <typename Callback>
+    void querySegment(const glm::vec3& start, const glm::vec3& end, Callback&& callback);
+
+    size_t getItemCount() const { return m_items.size(); }
+    float getCellSize() const { return m_cellSize; }
+
+private:
+    // Long segments are clamped to this many cells; per-frame projectile steps never come close
+    static constexpr int MAX_SEGMENT_CELLS = 256;
+
+    float m_cellSize;
+    float m_invCellSize;
+    uint32_t m_bucketMask;
+
+    std::vector<Item> m_items;
+    std::vector<uint32_t> m_bucketStart; // Size bucketCount + 1, prefix sums into m_entries
+    std::vector<int> m_entries;          // Item indices grouped by bucket
+    std::vector<uint32_t> m_visitStamp;  // Per item, last query that reported it
+    uint32_t m_queryStamp;
+
+    glm::ivec3 cellOf(const glm::vec3& p) const {
+        return glm::ivec3(static_cast<int>(std::floor(p.x * m_invCellSize)),
+                          static_cast<int>(std::floor(p.y * m_invCellSize)),
+                          static_cast<int>(std::floor(p.z * m_invCellSize)));
+    }
+
+    uint32_t bucketOf(const glm::ivec3& cell) const {
+        uint32_t h = static_cast<uint32_t>(cell.x) * 73856093u ^
+                     static_cast<uint32_t>(cell.y) * 19349663u ^
+                     static_cast<uint32_t>(cell.z) * 83492791u;
+        return h & m_bucketMask;
+    }
+
+    // Report every not-yet-seen item in the cell's bucket; false if the callback asked to stop
+    template <typename Callback>
+    bool visitCell(const glm::ivec3& cell, Callback& callback);
+};
+
+template <typename Callback>
+bool SpatialHashGrid::visitCell(const glm::ivec3& cell, Callback& callback) {
+    uint32_t bucket = bucketOf(cell);
+    for (uint32_t i = m_bucketStart[bucket]; i < m_bucketStart[bucket + 1]; ++i) {
+        int itemIndex = m_entries[i];
+        if (m_visitStamp[itemIndex] == m_queryStamp) continue;
+        m_visitStamp[itemIndex] = m_queryStamp;
+        if (!callback(static_cast<const Item&>(m_items[itemIndex]))) return false;
+    }
+    return true;
+}
+
+template <typename Callback>
+void SpatialHashGrid::querySegment(const glm::vec3& start, const glm::vec3& end, Callback&& callback) {
+    if (m_items.empty() || m_bucketStart.empty()) return;
+
+    if (++m_queryStamp == 0) {
+        // Stamp wrapped around; forget every previous visit
+        std::fill(m_visitStamp.begin(), m_visitStamp.end(), 0u);
+        m_queryStamp = 1;
+    }
+
+    // 3D DDA (Amanatides & Woo) through the cells the segment crosses
+    glm::ivec3 cell = cellOf(start);
+    const glm::ivec3 lastCell = cellOf(end);
+    const glm::vec3 delta = end - start;
+
+    glm::ivec3 step;
+    glm::vec3 tMax;
+    glm::vec3 tDelta;
+    for (int i = 0; i < 3; ++i) {
+        if (delta[i] > 0.0f) {
+            step[i] = 1;
+            tDelta[i] = m_cellSize / delta[i];
+            tMax[i] = ((cell[i] + 1) * m_cellSize - start[i]) / delta[i];
+        } else if (delta[i] < 0.0f) {
+            step[i] = -1;
+            tDelta[i] = -m_cellSize / delta[i];
+            tMax[i] = (cell[i] * m_cellSize - start[i]) / delta[i];
+        } else {
+            step[i] = 0;
+            tDelta[i] = std::numeric_limits<float>::infinity();
+            tMax[i] = std::numeric_limits<float>::infinity();
+        }
+    }
+
+    for (int visited = 0; visited < MAX_SEGMENT_CELLS; ++visited) {
+        if (!visitCell(cell, callback)) return;
+        if (cell == lastCell) return;
+
+        // Advance along the axis whose next cell boundary is closest
+        int axis = (tMax.x < tMax.y) ? ((tMax.x < tMax.z) ? 0 : 2) : ((tMax.y < tMax.z) ? 1 : 2);
+        if (tMax[axis] > 1.0f) return;
+        cell[axis] += step[axis];
+        tMax[axis] += tDelta[axis];
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include "Systems/TrianglePacket.h"
+
+struct Vertex;
+
+// Bounding volume hierarchy over the triangles of a single collision mesh.
+// Built once at level load; answers ray queries in O(log n) instead of
+// walking every triangle. Each leaf's triangles are also stored as SoA packets
+// so a leaf is tested with one TriangleKernel call.
+class TriangleBVH {
+public:
+    struct Triangle {
+        glm::vec3 v0;
+        glm::vec3 v1;
+        glm::vec3 v2;
+    };
+
+    TriangleBVH() = default;
+
+    // Build from indexed mesh data (out-of-range indices and trailing partial triangles are skipped)
+    void build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+    // Build from an explicit triangle soup
+    void build(std::vector<Triangle> triangles);
+
+    // Closest hit along origin + direction * t with t in (0, maxT]. Direction does not need to be normalized.
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, float& outT) const;
+
+    // Returns as soon as any triangle is hit within (0, maxT]
+    bool raycastAny(const glm::vec3& origin, const glm::vec3& direction, float maxT) const;
+
+    bool empty() const { return m_nodes.empty(); }
+    size_t getTriangleCount() const { return m_triangles.size(); }
+    // In BVH leaf order, not the order they were built from
+    const std::vector<Triangle>& getTriangles() const { return m_triangles; }
+    size_t getNodeCount() const { return m_nodes.size(); }
+    size_t getPacketCount() const { return m_packets.size(); }
+
+private:
+    friend class LevelCache;
+
+    struct Node {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        int leftFirst; // Left child index for inner nodes, first triangle for leaves
+        int count;     // Triangle count; 0 for inner nodes
+    };
+
+    // One full packet per leaf
+    static constexpr int MAX_LEAF_TRIANGLES = TRIANGLE_PACKET_WIDTH;
+    static constexpr int SAH_BINS = 12;
+    static constexpr int MAX_DEPTH = 48;
+
+    std::vector<Triangle> m_triangles;
+    std::vector<Node> m_nodes;
+
+    // Derived from the two above: packets of each leaf in order, and per node the first one
+    std::vector<TrianglePacket> m_packets;
+    std::vector<int> m_nodePackets;
+
+    void buildPackets();
+    void updateBounds(Node& node) const;
+    void subdivide(int nodeIndex, std::vector<glm::vec3>& centroids);
+    bool traverse(const glm::vec3& origin, const glm::vec3& direction, float maxT, bool anyHit, float& outT) const;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <atomic>
+
+// Collision triangles in SoA form: TRIANGLE_PACKET_WIDTH triangles per packet with the first
+// vertex and both edges precomputed, so one Möller–Trumbore pass tests the whole packet.
+// Unused lanes have zero edges and never report a hit.
+constexpr int TRIANGLE_PACKET_WIDTH = 8;
+
+struct alignas(32) TrianglePacket {
+    float v0x[TRIANGLE_PACKET_WIDTH], v0y[TRIANGLE_PACKET_WIDTH], v0z[TRIANGLE_PACKET_WIDTH];
+    float e1x[TRIANGLE_PACKET_WIDTH], e1y[TRIANGLE_PACKET_WIDTH], e1z[TRIANGLE_PACKET_WIDTH];
+    float e2x[TRIANGLE_PACKET_WIDTH], e2y[TRIANGLE_PACKET_WIDTH], e2z[TRIANGLE_PACKET_WIDTH];
+
+    TrianglePacket();
+    void set(int lane, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2);
+};
+
+// Ray vs. triangle packet intersection with runtime CPU dispatch.
+// The widest kernel the CPU supports is picked on first use: AVX2 (8 lanes at once),
+// SSE2 (two 4-lane halves) or a scalar loop. All three give the same answers as
+// RaycastUtility::rayTriangleIntersection.
+class TriangleKernel {
+public:
+    enum class Level {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    // Nearest lane hit with t in (epsilon, maxT]; returns the lane (-1 on a miss) and writes outT.
+    // Direction does not need to be normalized.
+    static int intersect(const TrianglePacket& packet, const glm::vec3& origin, const glm::vec3& direction,
+                         float maxT, float& outT) {
+        return s_intersect.load(std::memory_order_relaxed)(packet, origin, direction, maxT, outT);
+    }
+
+    static Level getBestSupported();
+    static Level getActive();
+    // Force a kernel (clamped to what the CPU supports); for benchmarks and debugging
+    static void setActive(Level level);
+    static const char* getName(Level level);
+
+private:
+    using IntersectFn = int (*)(const TrianglePacket&, const glm::vec3&, const glm::vec3&, float, float&);
+
+    // Starts out pointing at a stub that picks the best kernel on the first call
+    static std::atomic<IntersectFn> s_intersect;
+
+    static IntersectFn getKernel(Level level);
+    static int intersectFirstCall(const TrianglePacket& packet, const glm::vec3& origin, const glm::vec3& direction,
+                                  float maxT, float& outT);
+};
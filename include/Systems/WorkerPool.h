@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads that stay alive between calls, for per-frame work that is split into a
+// handful of tasks. The calling thread takes tasks too, so run() with N workers uses N + 1 threads.
+class WorkerPool {
+public:
+    explicit WorkerPool(int workerCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Workers plus the calling thread
+    size_t getThreadCount() const { return m_workers.size() + 1; }
+
+    // Calls task(i) for every i in [0, taskCount) and returns once all of them have finished.
+    // A call made while another run() is in progress executes its tasks on the calling thread.
+    void run(size_t taskCount, const std::function<void(size_t)>& task);
+
+private:
+    void workerLoop();
+    bool hasTask() const { return m_task && m_nextTask < m_taskCount; }
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_runMutex; // Held for the whole of a parallel run()
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_finished;
+
+    const std::function<void(size_t)>* m_task;
+    size_t m_taskCount;
+    size_t m_nextTask;
+    size_t m_unfinished;
+    bool m_stopping;
+};
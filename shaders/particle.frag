@@ -4,7 +4,7 @@ out vec4 FragColor;
 in float particleDepth;
 in vec2 uv;
 
-uniform vec4 particleColor;
+in vec4 particleColor;
 
 void main()
 {
@@ -1,16 +1,22 @@
 #version 460 core
 layout (location = 0) in vec3 aPos;
+// Per-instance attributes (divisor 1)
+layout (location = 1) in vec4 aPositionSize; // xyz = position, w = size
+layout (location = 2) in vec4 aColor;
 
 out float particleDepth;
 out vec2 uv;
+out vec4 particleColor;
 
 uniform mat4 projection;
 uniform mat4 view;
-uniform vec3 particlePos;
-uniform float particleSize;
 
 void main()
 {
+    vec3 particlePos = aPositionSize.xyz;
+    float particleSize = aPositionSize.w;
+    particleColor = aColor;
+
     // Billboard effect - particle always faces camera
     vec3 cameraRight = vec3(view[0][0], view[1][0], view[2][0]);
     vec3 cameraUp = vec3(view[0][1], view[1][1], view[2][1]);
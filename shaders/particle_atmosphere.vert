@@ -0,0 +1,89 @@
+#version 460 core
+// Stateless atmospheric dust: every mote is derived from a hash of its instance ID and the
+// current time, so nothing is stored or uploaded per mote. Each mote lives for a hashed
+// period, respawns at a new hashed spot every cycle and drifts like the pooled dust did.
+// Positions wrap in a box that follows the camera, so the box always appears full.
+layout (location = 0) in vec3 aPos;
+
+out float particleDepth;
+out vec2 uv;
+out vec4 particleColor;
+
+uniform mat4 projection;
+uniform mat4 view;
+uniform vec3 cameraPosition;
+uniform float time;
+uniform float radius;
+uniform float gravity;
+
+// lowbias32 integer hash
+uint hash(uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// The animation repeats after this many seconds; the CPU wraps `time` at the same value
+// (ParticleSystem::ATMOSPHERE_PERIOD) so it never grows large enough to lose precision
+const float ANIMATION_PERIOD = 420.0;
+
+// Uniform in [0, 1), one independent stream per (seed, slot)
+float random(uint seed, uint slot)
+{
+    return float(hash(seed * 16u + slot) >> 8) * (1.0 / 16777216.0);
+}
+
+void main()
+{
+    uint id = uint(gl_InstanceID);
+    uv = aPos.xy + vec2(0.5);
+
+    // Lifetime cycle of 3-7 s: a whole number of cycles fits in ANIMATION_PERIOD, so wrapping
+    // time keeps every mote's age and respawn sequence continuous. The phase offset keeps motes
+    // from respawning in lockstep.
+    float cyclesPerPeriod = floor(mix(60.0, 140.0, random(id, 0u)) + 0.5);
+    float life = ANIMATION_PERIOD / cyclesPerPeriod;
+    float cycleTime = time + random(id, 1u) * life;
+    float elapsedCycles = floor(cycleTime / life);
+    float age = cycleTime - elapsedCycles * life;
+    float cycle = mod(elapsedCycles, cyclesPerPeriod);
+    uint seed = hash(id ^ (uint(cycle) * 0x9e3779b9u));
+
+    // Same ranges the pooled dust used
+    vec3 velocity = vec3(mix(-0.05, 0.05, random(seed, 2u)), mix(0.01, 0.12, random(seed, 3u)), mix(-0.05, 0.05, random(seed, 4u)));
+    vec3 color = vec3(mix(0.85, 1.0, random(seed, 5u)), mix(0.85, 1.0, random(seed, 6u)), mix(0.9, 1.0, random(seed, 7u)));
+    float initialAlpha = mix(0.04, 0.18, random(seed, 8u));
+    float particleSize = mix(0.05, 0.25, random(seed, 9u));
+
+    // Box around the camera: 2r wide, from 0.25r below to 0.5r above
+    vec3 boxSize = vec3(2.0 * radius, 0.75 * radius, 2.0 * radius);
+    vec3 boxCenter = cameraPosition + vec3(0.0, 0.125 * radius, 0.0);
+    vec3 spawn = vec3(random(seed, 10u), random(seed, 11u), random(seed, 12u)) * boxSize;
+    vec3 world = spawn + velocity * age - vec3(0.0, 0.5 * gravity * age * age, 0.0);
+    vec3 offset = mod(world - boxCenter + 0.5 * boxSize, boxSize) - 0.5 * boxSize;
+    vec3 particlePos = boxCenter + offset;
+
+    // Fade with remaining life like pooled particles, and near the box faces where motes wrap
+    vec3 edge = abs(offset) / (0.5 * boxSize);
+    float edgeFade = 1.0 - smoothstep(0.8, 1.0, max(edge.x, max(edge.y, edge.z)));
+    particleColor = vec4(color, initialAlpha * (1.0 - age / life) * edgeFade);
+
+    // Billboard effect - particle always faces camera
+    vec3 cameraRight = vec3(view[0][0], view[1][0], view[2][0]);
+    vec3 cameraUp = vec3(view[0][1], view[1][1], view[2][1]);
+
+    vec4 viewPos = view * vec4(particlePos, 1.0);
+    float depth = -viewPos.z;
+    particleDepth = depth;
+    float sizeScale = 1.0 + (depth * 0.01);
+
+    vec3 vertexPos = particlePos
+                   + cameraRight * aPos.x * particleSize * sizeScale
+                   + cameraUp * aPos.y * particleSize * sizeScale;
+
+    gl_Position = projection * view * vec4(vertexPos, 1.0);
+}
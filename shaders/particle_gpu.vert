@@ -0,0 +1,57 @@
+#version 460 core
+// particle.vert for the compute-simulated path: instance data comes straight from the
+// particle ring SSBO instead of a per-instance vertex buffer.
+layout (location = 0) in vec3 aPos;
+
+struct GpuParticle {
+    vec4 positionSize; // xyz = position, w = size
+    vec4 velocityLife; // xyz = velocity, w = remaining life
+    vec4 color;
+    vec4 fade;         // x = 1 / initial life, y = initial alpha
+};
+
+layout (std430, binding = 0) readonly buffer ParticleRing {
+    GpuParticle particles[];
+};
+
+out float particleDepth;
+out vec2 uv;
+out vec4 particleColor;
+
+uniform mat4 projection;
+uniform mat4 view;
+
+void main()
+{
+    GpuParticle p = particles[gl_InstanceID];
+    particleColor = p.color;
+    uv = aPos.xy + vec2(0.5);
+
+    // Dead slot: park every corner at the same point outside the clip volume
+    if (p.velocityLife.w <= 0.0) {
+        particleDepth = 0.0;
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    vec3 particlePos = p.positionSize.xyz;
+    float particleSize = p.positionSize.w;
+
+    // Billboard effect - particle always faces camera
+    vec3 cameraRight = vec3(view[0][0], view[1][0], view[2][0]);
+    vec3 cameraUp = vec3(view[0][1], view[1][1], view[2][1]);
+
+    // Scale based on distance for depth perception
+    vec4 viewPos = view * vec4(particlePos, 1.0);
+    float depth = -viewPos.z;
+    particleDepth = depth;
+
+    // Slight size scaling based on distance
+    float sizeScale = 1.0 + (depth * 0.01);
+
+    vec3 vertexPos = particlePos
+                   + cameraRight * aPos.x * particleSize * sizeScale
+                   + cameraUp * aPos.y * particleSize * sizeScale;
+
+    gl_Position = projection * view * vec4(vertexPos, 1.0);
+}
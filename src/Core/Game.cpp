@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <filesystem>
 #include <ctime>
+#include <chrono>
 #include <cstdlib>
 
 #include <glad/gl.h>
@@ -40,6 +41,8 @@ Game::Game()
       hud(nullptr),
     debugRenderer(nullptr),
       weaponRenderer(),
+      platformTree(0.0f), // Platforms never move, so no fattening is needed
+      projectiles(Config::MAX_PROJECTILES),
       pickupKey(GLFW_KEY_E),
       lastGlfwTime(0.0f),
       explosionTimer(0.0f),
@@ -228,6 +231,40 @@ bool Game::initialize() {
             ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
             ImGui::Begin("Performance", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs);
             ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "FPS: %.1f", ImGui::GetIO().Framerate);
+            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Projectiles: %zu / %zu (peak %zu, dropped %zu)",
+                               this->projectiles.size(), this->projectiles.capacity(),
+                               this->projectiles.getHighWaterMark(), this->projectiles.getDroppedCount());
+            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "LOS rays: %d (%d enemies skipped)",
+                               this->perception.getRayCount(), this->perception.getSkippedCount());
+            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "AI LOD: full %d/%d, medium %d/%d, far %d/%d (updated/total)",
+                               this->aiLod.getUpdatedCount(AILodScheduler::Tier::Full), this->aiLod.getEnemyCount(AILodScheduler::Tier::Full),
+                               this->aiLod.getUpdatedCount(AILodScheduler::Tier::Medium), this->aiLod.getEnemyCount(AILodScheduler::Tier::Medium),
+                               this->aiLod.getUpdatedCount(AILodScheduler::Tier::Far), this->aiLod.getEnemyCount(AILodScheduler::Tier::Far));
+            int sleepingEnemies = 0;
+            for (const auto& enemy : this->enemies) {
+                if (enemy.isAlive() && enemy.isSleeping()) sleepingEnemies++;
+            }
+            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Sleeping enemies: %d", sleepingEnemies);
+            Mesh::MemoryStats levelMemory = Mesh::getMemoryStats(MeshCategory::Level);
+            Mesh::MemoryStats weaponMemory = Mesh::getMemoryStats(MeshCategory::Weapon);
+            Mesh::MemoryStats primitiveMemory = Mesh::getMemoryStats(MeshCategory::Primitive);
+            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Mesh KB (CPU/GPU): level %zu/%zu, weapons %zu/%zu, primitives %zu/%zu",
+                               levelMemory.cpuBytes / 1024, levelMemory.gpuBytes / 1024,
+                               weaponMemory.cpuBytes / 1024, weaponMemory.gpuBytes / 1024,
+                               primitiveMemory.cpuBytes / 1024, primitiveMemory.gpuBytes / 1024);
+            if (particleSystem) {
+                static const char* categoryNames[] = {"dust", "muzzle", "impact", "smoke"};
+                ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Particles: %zu (emitted/dropped/evicted/culled)",
+                                   particleSystem->getParticleCount());
+                for (int i = 0; i < static_cast<int>(ParticleCategory::Count); ++i) {
+                    const ParticleSystem::CategoryStats& stats = particleSystem->getCategoryStats(static_cast<ParticleCategory>(i));
+                    ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "  %-7s %llu/%llu/%llu/%llu", categoryNames[i],
+                                       static_cast<unsigned long long>(stats.emitted),
+                                       static_cast<unsigned long long>(stats.dropped),
+                                       static_cast<unsigned long long>(stats.evicted),
+                                       static_cast<unsigned long long>(stats.culled));
+                }
+            }
             ImGui::End();
         }
     };
@@ -239,6 +276,7 @@ bool Game::initialize() {
     postProcessing = std::make_unique<PostProcessingSystem>(settings.window.width, settings.window.height);
     resourceManager = std::make_unique<ResourceManager>();
     physicsSystem = std::make_unique<PhysicsSystem>(*this);
+    pathRequestService = std::make_unique<PathRequestService>(Config::PATH_WORKER_THREADS);
     shadowSystem = std::make_unique<ShadowSystem>(2048);
 
     initializeOpenGLState();
@@ -361,7 +399,7 @@ void Game::loadResources() {
         if (strlen(weaponData.modelPath) == 0) continue;
 
         std::cout << "  - Loading " << weaponData.name << " from " << weaponData.modelPath << "..." << std::endl;
-        auto meshes = ModelLoader::loadModel(weaponData.modelPath);
+        auto meshes = ModelLoader::loadModel(weaponData.modelPath, MeshCategory::Weapon);
         if (meshes.empty()) {
             std::cerr << "Warning: Failed to load " << weaponData.name << " model, falling back to procedural" << std::endl;
             meshes.push_back(GeometryFactory::createWeaponMesh());
@@ -389,6 +427,9 @@ void Game::loadResources() {
     particleSystem->enableAtmospheric(true);
     particleSystem->setAtmosphereRate(8);   // particles per second
     particleSystem->setAtmosphereRadius(25.0f); // spawn radius around camera
+    particleSystem->setAtmosphereProcedural(true); // motes come from the vertex shader, not the pool
+    particleSystem->setAtmosphereMoteCount(300);
+    particleSystem->setGpuSimulation(Settings::getInstance().graphics.gpuParticles);
 
     debugRenderer = std::make_unique<DebugRenderer>();
 
@@ -414,6 +455,12 @@ void Game::loadLevel(int level) {
     Settings::getInstance().save();
     
     currentLevel = level;
+
+    // Stop path workers from touching the graph (and drop results for the old enemy list)
+    if (pathRequestService) {
+        pathRequestService->setGraph(nullptr);
+    }
+
     if (levelManager) {
         levelManager->loadLevel(level);
     }
@@ -427,13 +474,13 @@ void Game::loadLevel(int level) {
     m_timeScale = 1.0f;
     
     // Build navigation graph after level is loaded
-    if (!navigationGraph) {
-        navigationGraph = std::make_unique<NavigationGraph>();
+    buildNavigation(level);
+    playerFlowField.invalidate();
+    perception.clear();
+    aiLod.clear();
+    if (pathRequestService) {
+        pathRequestService->setGraph(navigationGraph.get());
     }
-    navigationGraph->buildFromPlatforms(platforms);
-    
-    std::cout << "[NavigationGraph] Built with " << navigationGraph->getNodes().size() 
-              << " nodes and " << navigationGraph->getEdges().size() << " edges" << std::endl;
     
     state = GameState::PLAYING;
     syncMusicWithState(true);
@@ -444,6 +491,88 @@ void Game::loadLevel(int level) {
     lastGlfwTime = glfwGetTime();
 }
 
+void Game::buildNavigation(int level) {
+    if (!navigationGraph) {
+        navigationGraph = std::make_unique<NavigationGraph>();
+    }
+    
+    // The level cache holds the graph built last time from this exact .glb
+    if (levelManager->restoreNavigation(*navigationGraph)) {
+        std::cout << "[NavigationGraph] Restored " << navigationGraph->getNodes().size() << " nodes and "
+                  << navigationGraph->getEdges().size() << " edges from the level cache" << std::endl;
+    } else {
+        // Prefer a navmesh of the real level surfaces; fall back to one node per platform
+        // (hardcoded fallback level, or geometry without any walkable area)
+        bool builtFromNavMesh = false;
+        if (Config::NAV_USE_NAVMESH) {
+            std::vector<glm::vec3> triangles;
+            levelManager->getLevelTriangles(triangles);
+            if (!triangles.empty()) {
+                NavMesh navMesh;
+                navMesh.build(triangles, NavMesh::defaultSettings());
+                std::cout << "[NavMesh] " << navMesh.getPolygons().size() << " polygons from "
+                          << triangles.size() / 3 << " triangles (" << navMesh.getWalkableCellCount()
+                          << " walkable cells) in " << navMesh.getLastBuildTimeMs() << " ms" << std::endl;
+                if (!navMesh.empty()) {
+                    navigationGraph->buildFromNavMesh(std::move(navMesh));
+                    builtFromNavMesh = true;
+                }
+            }
+        }
+        if (!builtFromNavMesh) {
+            navigationGraph->buildFromPlatforms(platforms, &platformTree, Config::NAV_VALIDATE_EDGES);
+        }
+        
+        std::cout << "[NavigationGraph] Built with " << navigationGraph->getNodes().size() 
+                  << " nodes and " << navigationGraph->getEdges().size() << " edges in "
+                  << navigationGraph->getLastBuildTimeMs() << " ms";
+        if (Config::NAV_VALIDATE_EDGES && !builtFromNavMesh) {
+            std::cout << " (" << navigationGraph->getRejectedEdgeCount() << " links rejected by validation)";
+        }
+        std::cout << std::endl;
+        
+        levelManager->saveLevelCache(*navigationGraph);
+    }
+    
+    if (navigationGraph->hasHierarchy()) {
+        const HierarchicalPathfinder& hierarchy = navigationGraph->getHierarchy();
+        std::cout << "[NavigationGraph] Hierarchy: " << hierarchy.getClusterCount() << " clusters, "
+                  << hierarchy.getEntranceCount() << " entrances, "
+                  << hierarchy.getAbstractEdgeCount() << " abstract edges" << std::endl;
+    }
+    
+    // Use the baked routing table if one matches this graph
+    std::string tablePath = LevelManager::getLevelFilePath(level, ".nexthop");
+    if (navigationGraph->loadNextHopTable(tablePath)) {
+        std::cout << "[NavigationGraph] Loaded next-hop table " << tablePath << " ("
+                  << navigationGraph->getNextHopTable().getMemoryBytes() / 1024 << " KB)" << std::endl;
+    }
+}
+
+void Game::bakeNavigationTables() {
+    if (!levelManager) {
+        return;
+    }
+    
+    for (int level = 1; levelManager->levelExists(level); ++level) {
+        levelManager->loadLevel(level);
+        buildNavigation(level);
+        
+        auto start = std::chrono::steady_clock::now();
+        if (!navigationGraph->bakeNextHopTable()) {
+            std::cerr << "[NavigationGraph] Could not bake a next-hop table for level " << level << std::endl;
+            continue;
+        }
+        float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        std::string tablePath = LevelManager::getLevelFilePath(level, ".nexthop");
+        if (navigationGraph->saveNextHopTable(tablePath)) {
+            std::cout << "[NavigationGraph] Baked " << tablePath << " in " << elapsedMs << " ms ("
+                      << navigationGraph->getNextHopTable().getMemoryBytes() / 1024 << " KB)" << std::endl;
+        }
+    }
+}
+
 void Game::loadSkybox(int levelIndex) {
     const auto& levelConfig = Config::Levels::getLevelConfig(levelIndex);
     std::string hdrPath = levelConfig.skyboxPath;
@@ -686,7 +815,7 @@ void Game::update(float deltaTime) {
                         spreadDir += glm::vec3(r1, r2, r3);
                         spreadDir = glm::normalize(spreadDir);
                     }
-                    projectiles.emplace_back(muzzlePos, spreadDir, speed, damage, lifetime);
+                    projectiles.spawn(muzzlePos, spreadDir, speed, damage, lifetime);
                 }
 
                 if (particleSystem) {
@@ -766,16 +895,47 @@ void Game::update(float deltaTime) {
             }
         }
 
+        // Refresh the shared flow field (only rebuilds when the player reaches a new nav node)
+        const FlowField* flowField = nullptr;
+        if (Config::AI_USE_FLOW_FIELD && navigationGraph) {
+            playerFlowField.update(*navigationGraph, player.getPosition());
+            flowField = &playerFlowField;
+        }
+
+        // Hand finished paths back to their enemies, then open this frame's solve budget
+        PathRequestService* pathService = pathRequestService.get();
+        if (pathService) {
+            pathService->takeCompleted(completedPaths);
+            for (auto& result : completedPaths) {
+                if (result.requesterId >= 0 && result.requesterId < static_cast<int>(enemies.size())) {
+                    enemies[result.requesterId].onPathReady(result.ticket, std::move(result.path), std::move(result.abstractPath));
+                }
+            }
+            pathService->update(Config::PATH_REQUEST_BUDGET_MS);
+        }
+
+        // Pick which enemies run this frame (tiers use last tick's visibility), then one
+        // line-of-sight pass for those; update and the debug overlay read the results
+        aiLod.update(enemies, player.getPosition(), perception, worldDeltaTime);
+        perception.update(enemies, player.getPosition(), platforms, &platformTree, &aiLod.getActiveMask());
+
         // Update Enemies
         bool anyEnemyAlive = false;
-        for (auto& enemy : enemies) {
+        for (size_t enemyIndex = 0; enemyIndex < enemies.size(); ++enemyIndex) {
+            Enemy& enemy = enemies[enemyIndex];
             if (!enemy.isAlive()) {
                 continue;
             }
             anyEnemyAlive = true;
+            if (!aiLod.shouldUpdate(enemyIndex)) {
+                continue;
+            }
+            enemy.setSimplifiedPhysics(aiLod.getTier(enemyIndex) != AILodScheduler::Tier::Full);
 
             // Pass audioSystem to allow enemy to play alert SFX when it loses sight
-            enemy.update(worldDeltaTime, player.getPosition(), navigationGraph.get(), platforms, audioSystem.get());
+            enemy.update(aiLod.consumeDeltaTime(enemyIndex), player.getPosition(), perception.hasLineOfSight(enemyIndex),
+                         navigationGraph.get(), flowField,
+                         pathService, static_cast<int>(enemyIndex), platforms, &platformTree, audioSystem.get());
 
             if (enemy.shouldShoot(m_accumulatedTime)) {
                 Weapon* enemyWeapon = enemy.getWeapon();
@@ -801,7 +961,7 @@ void Game::update(float deltaTime) {
                         }
                         
                         // Spawn Enemy Projectile (isEnemy=true)
-                        projectiles.emplace_back(muzzlePos, currentSpreadDir, speed, damage, lifetime, true);
+                        projectiles.spawn(muzzlePos, currentSpreadDir, speed, damage, lifetime, true);
                     }
 
                     // Play enemy fire sound from weapon config
@@ -904,6 +1064,9 @@ void Game::applySettings() {
 
     // Graphics
     techStyleIntensity = settings.graphics.techStyleIntensity;
+    if (particleSystem) {
+        particleSystem->setGpuSimulation(settings.graphics.gpuParticles);
+    }
     
     if (settings.graphics.gammaCorrection) {
         glEnable(GL_FRAMEBUFFER_SRGB);
@@ -1023,13 +1186,14 @@ void Game::render() {
             }
             
             // Draw enemy paths
-            for (const auto& enemy : enemies) {
+            for (size_t enemyIndex = 0; enemyIndex < enemies.size(); ++enemyIndex) {
+                const Enemy& enemy = enemies[enemyIndex];
                 if (!enemy.isAlive()) continue;
                 
-                // Draw line of sight check
+                // Draw this tick's line of sight result
                 glm::vec3 enemyEye = enemy.getPosition() + glm::vec3(0.0f, 1.6f, 0.0f);
                 glm::vec3 playerEye = player.getEyePosition();
-                bool hasLOS = enemy.canSeePlayer(player.getPosition());
+                bool hasLOS = perception.hasLineOfSight(enemyIndex);
                 glm::vec3 losColor = hasLOS ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.5f, 0.5f, 0.5f);
                 debugRenderer->addLine(enemyEye, playerEye, losColor, 0.0f);
             }
@@ -0,0 +1,557 @@
+#include "LevelCache.h"
+#include "Config.h"
+#include "Entities/Platform.h"
+#include "Systems/AABBTree.h"
+#include "Systems/NavigationGraph.h"
+#include "Systems/TriangleBVH.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+namespace {
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash = FNV_OFFSET) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Appends raw values and length-prefixed arrays in native byte order
+class Writer {
+public:
+    template <typename T>
+    void value(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "cache values must be plain data");
+        append(&v, sizeof(T));
+    }
+
+    template <typename T>
+    void array(const std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "cache arrays must hold plain data");
+        value(static_cast<uint64_t>(v.size()));
+        append(v.data(), v.size() * sizeof(T));
+    }
+
+    std::vector<char>& bytes() { return m_bytes; }
+
+private:
+    std::vector<char> m_bytes;
+
+    void append(const void* data, size_t size) {
+        const char* begin = static_cast<const char*>(data);
+        m_bytes.insert(m_bytes.end(), begin, begin + size);
+    }
+};
+
+// Bounds-checked counterpart of Writer; once a read fails every later read fails too
+class Reader {
+public:
+    Reader(const char* data, size_t size) : m_data(data), m_size(size), m_offset(0), m_ok(true) {}
+
+    template <typename T>
+    bool value(T& v) {
+        if (!m_ok || m_size - m_offset < sizeof(T)) return m_ok = false;
+        std::memcpy(&v, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool array(std::vector<T>& v) {
+        uint64_t count = 0;
+        if (!value(count) || count > (m_size - m_offset) / (sizeof(T) > 0 ? sizeof(T) : 1)) return m_ok = false;
+        v.resize(static_cast<size_t>(count));
+        if (v.empty()) return true; // data() may be null
+        std::memcpy(v.data(), m_data + m_offset, v.size() * sizeof(T));
+        m_offset += v.size() * sizeof(T);
+        return true;
+    }
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_ok && m_offset == m_size; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_offset;
+    bool m_ok;
+};
+
+// CSR offsets: count + 1 non-decreasing entries from 0 to items.size()
+template <typename T>
+bool validOffsets(const std::vector<int>& offsets, size_t count, const std::vector<T>& items) {
+    if (offsets.size() != count + 1 || offsets.front() != 0 || static_cast<size_t>(offsets.back()) != items.size()) {
+        return false;
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        if (offsets[i] < offsets[i - 1]) return false;
+    }
+    return true;
+}
+
+// Every value in [minValue, end)
+bool valuesInRange(const std::vector<int>& values, int minValue, size_t end) {
+    for (int value : values) {
+        if (value < minValue || (value >= 0 && static_cast<size_t>(value) >= end)) return false;
+    }
+    return true;
+}
+
+// A negative edge cost lets A* loop through cameFrom forever
+bool validCosts(const std::vector<float>& costs) {
+    for (float cost : costs) {
+        if (!std::isfinite(cost) || cost < 0.0f) return false;
+    }
+    return true;
+}
+}
+
+bool LevelCache::hashFile(const std::string& path, uint64_t& outHash) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    uint64_t hash = FNV_OFFSET;
+    std::vector<char> chunk(1 << 16);
+    while (file) {
+        file.read(chunk.data(), chunk.size());
+        hash = fnv1a(chunk.data(), static_cast<size_t>(file.gcount()), hash);
+    }
+    outHash = hash;
+    return true;
+}
+
+uint64_t LevelCache::settingsHash() {
+    // Every Config value that changes collision or navigation data built from the same .glb
+    struct {
+        float broadphaseMargin = Config::BROADPHASE_MARGIN;
+        float maxStepHeight = Config::NAV_MAX_STEP_HEIGHT;
+        float cellSize = Config::NAV_CELL_SIZE;
+        float cellHeight = Config::NAV_CELL_HEIGHT;
+        float maxSlope = Config::NAV_MAX_SLOPE_DEGREES;
+        float playerHeight = Config::PLAYER_HEIGHT;
+        float playerWidth = Config::PLAYER_WIDTH;
+        float clusterSize = Config::NAV_CLUSTER_SIZE;
+        int hierarchyMinNodes = Config::NAV_HIERARCHY_MIN_NODES;
+        int useNavMesh = Config::NAV_USE_NAVMESH ? 1 : 0;
+        int validateEdges = Config::NAV_VALIDATE_EDGES ? 1 : 0;
+    } settings;
+    return fnv1a(&settings, sizeof(settings));
+}
+
+bool LevelCache::save(const std::string& path, uint64_t sourceHash,
+                      const std::vector<Platform>& platforms,
+                      const AABBTree& broadphase,
+                      const NavigationGraph& graph) {
+    std::vector<std::pair<uint32_t, std::vector<char>>> sections;
+
+    // Collision BVHs, in the order the level loader creates platforms with geometry
+    {
+        Writer w;
+        uint64_t count = 0;
+        for (const Platform& platform : platforms) count += platform.hasCollisionMesh() ? 1 : 0;
+        w.value(count);
+        for (const Platform& platform : platforms) {
+            if (!platform.hasCollisionMesh()) continue;
+            const TriangleBVH& bvh = platform.getCollisionMesh().getBVH();
+            w.array(bvh.m_triangles);
+            w.array(bvh.m_nodes);
+        }
+        sections.push_back({SECTION_COLLISION_BVHS, std::move(w.bytes())});
+    }
+
+    {
+        Writer w;
+        w.array(broadphase.m_nodes);
+        w.value(broadphase.m_root);
+        w.value(broadphase.m_freeList);
+        w.value(broadphase.m_proxyCount);
+        w.value(broadphase.m_margin);
+        sections.push_back({SECTION_BROADPHASE, std::move(w.bytes())});
+    }
+
+    {
+        Writer w;
+        w.value(static_cast<uint64_t>(graph.nodes.size()));
+        for (const NavNode& node : graph.nodes) {
+            w.value(node.position);
+            w.value(node.platformIndex);
+        }
+        w.value(static_cast<uint64_t>(graph.edges.size()));
+        for (const NavEdge& edge : graph.edges) {
+            w.value(edge.fromNode);
+            w.value(edge.toNode);
+            w.value(edge.cost);
+        }
+        w.array(graph.adjacencyOffsets);
+        w.array(graph.adjacencyTargets);
+        w.array(graph.adjacencyCosts);
+        w.value(graph.lastBuildTimeMs);
+        w.value(graph.rejectedEdgeCount);
+
+        const KDTree& kd = graph.nodeIndex;
+        w.array(kd.m_points);
+        w.array(kd.m_indices);
+        w.array(kd.m_splitAxis);
+
+        const NavMesh& mesh = graph.navMesh;
+        w.array(mesh.m_polygons);
+        w.array(mesh.m_portalOffsets);
+        w.array(mesh.m_portals);
+        w.value(mesh.m_maxStepHeight);
+        w.value(mesh.m_bucketOrigin);
+        w.value(mesh.m_bucketSize);
+        w.value(mesh.m_bucketsX);
+        w.value(mesh.m_bucketsZ);
+        w.array(mesh.m_bucketOffsets);
+        w.array(mesh.m_bucketPolygons);
+        w.value(mesh.m_lastBuildTimeMs);
+        w.value(static_cast<uint64_t>(mesh.m_walkableCellCount));
+
+        const HierarchicalPathfinder& hierarchy = graph.hierarchy;
+        w.value(static_cast<uint8_t>(hierarchy.isBuilt() ? 1 : 0));
+        w.value(hierarchy.m_clusterCount);
+        w.array(hierarchy.m_clusterOf);
+        w.array(hierarchy.m_abstractIndex);
+        w.array(hierarchy.m_entranceNodes);
+        w.array(hierarchy.m_clusterEntranceOffsets);
+        w.array(hierarchy.m_clusterEntrances);
+        w.array(hierarchy.m_abstractOffsets);
+        w.array(hierarchy.m_abstractTargets);
+        w.array(hierarchy.m_abstractCosts);
+        sections.push_back({SECTION_NAVIGATION, std::move(w.bytes())});
+    }
+
+    Writer file;
+    file.value(FILE_MAGIC);
+    file.value(FILE_VERSION);
+    file.value(sourceHash);
+    file.value(settingsHash());
+    file.value(static_cast<uint32_t>(sections.size()));
+    for (const auto& [tag, payload] : sections) {
+        file.value(tag);
+        file.array(payload);
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "[LevelCache] Could not write " << path << std::endl;
+        return false;
+    }
+    out.write(file.bytes().data(), static_cast<std::streamsize>(file.bytes().size()));
+    return static_cast<bool>(out);
+}
+
+void LevelCache::clear() {
+    m_data = std::vector<char>();
+    m_sections.clear();
+}
+
+bool LevelCache::load(const std::string& path, uint64_t sourceHash) {
+    clear();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+
+    std::vector<char> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+        std::cerr << "[LevelCache] Could not read " << path << std::endl;
+        return false;
+    }
+
+    Reader r(data.data(), data.size());
+    uint32_t magic = 0, version = 0, sectionCount = 0;
+    uint64_t storedSource = 0, storedSettings = 0;
+    r.value(magic);
+    r.value(version);
+    r.value(storedSource);
+    r.value(storedSettings);
+    r.value(sectionCount);
+    if (!r.ok() || magic != FILE_MAGIC || version != FILE_VERSION) {
+        std::cerr << "[LevelCache] " << path << " is not a cache of this version; ignoring it" << std::endl;
+        return false;
+    }
+    if (storedSource != sourceHash || storedSettings != settingsHash()) {
+        std::cout << "[LevelCache] " << path << " is out of date; it will be rebuilt" << std::endl;
+        return false;
+    }
+
+    // Index sections in place; payloads are parsed on demand by the restore calls
+    std::vector<Section> sections;
+    size_t offset = sizeof(magic) + sizeof(version) + sizeof(storedSource) + sizeof(storedSettings) + sizeof(sectionCount);
+    for (uint32_t i = 0; i < sectionCount; ++i) {
+        uint32_t tag = 0;
+        uint64_t size = 0;
+        Reader header(data.data() + offset, data.size() - offset);
+        if (!header.value(tag) || !header.value(size) || size > data.size() - offset - sizeof(tag) - sizeof(size)) {
+            std::cerr << "[LevelCache] " << path << " is truncated" << std::endl;
+            return false;
+        }
+        offset += sizeof(tag) + sizeof(size);
+        sections.push_back({tag, offset, static_cast<size_t>(size)});
+        offset += static_cast<size_t>(size);
+    }
+
+    m_data = std::move(data);
+    m_sections = std::move(sections);
+    return true;
+}
+
+const LevelCache::Section* LevelCache::findSection(uint32_t tag) const {
+    for (const Section& section : m_sections) {
+        if (section.tag == tag) return &section;
+    }
+    return nullptr;
+}
+
+bool LevelCache::restoreCollisionBVHs(std::vector<TriangleBVH>& outBVHs) const {
+    outBVHs.clear();
+    const Section* section = findSection(SECTION_COLLISION_BVHS);
+    if (!section) return false;
+
+    Reader r(m_data.data() + section->offset, section->size);
+    uint64_t count = 0;
+    if (!r.value(count)) return false;
+    // Each BVH takes at least its two array lengths
+    if (count > section->size / (2 * sizeof(uint64_t))) return false;
+
+    outBVHs.resize(static_cast<size_t>(count));
+    for (TriangleBVH& bvh : outBVHs) {
+        r.array(bvh.m_triangles);
+        r.array(bvh.m_nodes);
+    }
+    if (!r.atEnd()) {
+        outBVHs.clear();
+        return false;
+    }
+
+    // Leaves must stay inside the triangle array and children inside the node array. build()
+    // always places children after their parent, which also rules out cycles, and caps the
+    // depth so traversal fits its fixed stack.
+    std::vector<int> depth;
+    for (TriangleBVH& bvh : outBVHs) {
+        int64_t triangleCount = static_cast<int64_t>(bvh.m_triangles.size());
+        int64_t nodeCount = static_cast<int64_t>(bvh.m_nodes.size());
+        depth.assign(bvh.m_nodes.size(), 0);
+        for (int64_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+            const TriangleBVH::Node& node = bvh.m_nodes[static_cast<size_t>(nodeIndex)];
+            int nodeDepth = depth[static_cast<size_t>(nodeIndex)];
+            bool valid = node.count > 0
+                ? node.leftFirst >= 0 && node.leftFirst + static_cast<int64_t>(node.count) <= triangleCount
+                : node.count == 0 && node.leftFirst > nodeIndex && node.leftFirst + 1 < nodeCount &&
+                  nodeDepth < TriangleBVH::MAX_DEPTH;
+            if (!valid) {
+                outBVHs.clear();
+                return false;
+            }
+            if (node.count == 0) {
+                for (int child : {node.leftFirst, node.leftFirst + 1}) {
+                    depth[child] = std::max(depth[child], nodeDepth + 1);
+                }
+            }
+        }
+        bvh.buildPackets();
+    }
+    return true;
+}
+
+bool LevelCache::restoreBroadphase(AABBTree& tree, size_t platformCount) const {
+    const Section* section = findSection(SECTION_BROADPHASE);
+    if (!section) return false;
+
+    AABBTree restored;
+    Reader r(m_data.data() + section->offset, section->size);
+    r.array(restored.m_nodes);
+    r.value(restored.m_root);
+    r.value(restored.m_freeList);
+    r.value(restored.m_proxyCount);
+    r.value(restored.m_margin);
+    int nodeCount = static_cast<int>(restored.m_nodes.size());
+    if (!r.atEnd() || restored.m_root < AABBTree::NULL_NODE || restored.m_root >= nodeCount) {
+        return false;
+    }
+
+    // Walk the tree from the root: every node is reached at most once, children point back at
+    // their parent, leaves hold a platform index, heights agree with the children (rebalancing
+    // trusts them) and the depth fits the fixed traversal stacks
+    std::vector<uint8_t> seen(static_cast<size_t>(nodeCount), 0);
+    int leafCount = 0;
+    if (restored.m_root != AABBTree::NULL_NODE) {
+        if (restored.m_nodes[restored.m_root].parent != AABBTree::NULL_NODE) return false;
+
+        std::vector<std::pair<int, int>> pending{{restored.m_root, 1}}; // (node, depth)
+        while (!pending.empty()) {
+            auto [nodeId, depth] = pending.back();
+            pending.pop_back();
+            // query()/raycast() keep at most depth + 1 entries on their stack
+            if (seen[nodeId] || depth >= AABBTree::MAX_STACK) return false;
+            seen[nodeId] = 1;
+
+            const AABBTree::Node& node = restored.m_nodes[nodeId];
+            if (node.isLeaf()) {
+                if (node.child2 != AABBTree::NULL_NODE || node.height != 0 || node.userData < 0 ||
+                    static_cast<size_t>(node.userData) >= platformCount) {
+                    return false;
+                }
+                leafCount++;
+                continue;
+            }
+            for (int child : {node.child1, node.child2}) {
+                if (child < 0 || child >= nodeCount || restored.m_nodes[child].parent != nodeId) return false;
+                pending.push_back({child, depth + 1});
+            }
+            if (node.height != 1 + std::max(restored.m_nodes[node.child1].height, restored.m_nodes[node.child2].height)) {
+                return false;
+            }
+        }
+    }
+    if (leafCount != restored.m_proxyCount) {
+        return false;
+    }
+
+    // Unused nodes are chained through parent; the chain must end and stay clear of the tree
+    for (int nodeId = restored.m_freeList; nodeId != AABBTree::NULL_NODE; nodeId = restored.m_nodes[nodeId].parent) {
+        if (nodeId < 0 || nodeId >= nodeCount || seen[nodeId]) return false;
+        seen[nodeId] = 1;
+    }
+
+    tree = std::move(restored);
+    return true;
+}
+
+bool LevelCache::restoreNavigation(NavigationGraph& graph) const {
+    const Section* section = findSection(SECTION_NAVIGATION);
+    if (!section) return false;
+
+    graph.reset();
+    Reader r(m_data.data() + section->offset, section->size);
+
+    uint64_t nodeCount = 0;
+    if (!r.value(nodeCount) || nodeCount == 0 || nodeCount > section->size / sizeof(glm::vec3)) return false;
+    graph.nodes.reserve(static_cast<size_t>(nodeCount));
+    for (uint64_t i = 0; i < nodeCount && r.ok(); ++i) {
+        glm::vec3 position;
+        int platformIndex = -1;
+        r.value(position);
+        r.value(platformIndex);
+        graph.nodes.emplace_back(position, platformIndex);
+    }
+
+    uint64_t edgeCount = 0;
+    if (!r.value(edgeCount) || edgeCount > section->size / sizeof(float)) {
+        graph.reset();
+        return false;
+    }
+    graph.edges.reserve(static_cast<size_t>(edgeCount));
+    for (uint64_t i = 0; i < edgeCount && r.ok(); ++i) {
+        int from = 0, to = 0;
+        float cost = 0.0f;
+        r.value(from);
+        r.value(to);
+        r.value(cost);
+        graph.edges.emplace_back(from, to, cost);
+    }
+    r.array(graph.adjacencyOffsets);
+    r.array(graph.adjacencyTargets);
+    r.array(graph.adjacencyCosts);
+    r.value(graph.lastBuildTimeMs);
+    r.value(graph.rejectedEdgeCount);
+
+    KDTree& kd = graph.nodeIndex;
+    r.array(kd.m_points);
+    r.array(kd.m_indices);
+    r.array(kd.m_splitAxis);
+
+    NavMesh& mesh = graph.navMesh;
+    uint64_t walkableCells = 0;
+    r.array(mesh.m_polygons);
+    r.array(mesh.m_portalOffsets);
+    r.array(mesh.m_portals);
+    r.value(mesh.m_maxStepHeight);
+    r.value(mesh.m_bucketOrigin);
+    r.value(mesh.m_bucketSize);
+    r.value(mesh.m_bucketsX);
+    r.value(mesh.m_bucketsZ);
+    r.array(mesh.m_bucketOffsets);
+    r.array(mesh.m_bucketPolygons);
+    r.value(mesh.m_lastBuildTimeMs);
+    r.value(walkableCells);
+    mesh.m_walkableCellCount = static_cast<size_t>(walkableCells);
+
+    HierarchicalPathfinder& hierarchy = graph.hierarchy;
+    uint8_t hierarchyBuilt = 0;
+    r.value(hierarchyBuilt);
+    r.value(hierarchy.m_clusterCount);
+    r.array(hierarchy.m_clusterOf);
+    r.array(hierarchy.m_abstractIndex);
+    r.array(hierarchy.m_entranceNodes);
+    r.array(hierarchy.m_clusterEntranceOffsets);
+    r.array(hierarchy.m_clusterEntrances);
+    r.array(hierarchy.m_abstractOffsets);
+    r.array(hierarchy.m_abstractTargets);
+    r.array(hierarchy.m_abstractCosts);
+    hierarchy.m_graph = hierarchyBuilt ? &graph : nullptr;
+
+    // Structural and index range checks, so a damaged file cannot send queries out of bounds
+    const size_t nodes = graph.nodes.size();
+    bool valid = r.atEnd() &&
+                 validOffsets(graph.adjacencyOffsets, nodes, graph.adjacencyTargets) &&
+                 graph.adjacencyCosts.size() == graph.adjacencyTargets.size() &&
+                 valuesInRange(graph.adjacencyTargets, 0, nodes) && validCosts(graph.adjacencyCosts) &&
+                 kd.m_points.size() == nodes && kd.m_indices.size() == nodes && kd.m_splitAxis.size() == nodes &&
+                 valuesInRange(kd.m_indices, 0, nodes) &&
+                 std::all_of(kd.m_splitAxis.begin(), kd.m_splitAxis.end(), [](uint8_t axis) { return axis < 3; });
+    for (size_t i = 0; valid && i < graph.edges.size(); ++i) {
+        const NavEdge& edge = graph.edges[i];
+        valid = edge.fromNode >= 0 && static_cast<size_t>(edge.fromNode) < nodes &&
+                edge.toNode >= 0 && static_cast<size_t>(edge.toNode) < nodes &&
+                std::isfinite(edge.cost) && edge.cost >= 0.0f;
+    }
+
+    // Polygons double as nodes when the graph was built from a nav mesh
+    if (valid && !mesh.m_polygons.empty()) {
+        valid = mesh.m_polygons.size() == nodes && mesh.m_bucketsX >= 0 && mesh.m_bucketsZ >= 0 &&
+                validOffsets(mesh.m_portalOffsets, nodes, mesh.m_portals) &&
+                validOffsets(mesh.m_bucketOffsets, static_cast<size_t>(mesh.m_bucketsX) * mesh.m_bucketsZ,
+                             mesh.m_bucketPolygons) &&
+                valuesInRange(mesh.m_bucketPolygons, 0, nodes);
+        for (size_t i = 0; valid && i < mesh.m_portals.size(); ++i) {
+            int neighbor = mesh.m_portals[i].neighbor;
+            valid = neighbor >= 0 && static_cast<size_t>(neighbor) < nodes;
+        }
+    }
+
+    if (valid && hierarchyBuilt) {
+        const size_t clusters = static_cast<size_t>(std::max(hierarchy.m_clusterCount, 0));
+        const size_t entrances = hierarchy.m_entranceNodes.size();
+        valid = hierarchy.m_clusterCount >= 0 &&
+                hierarchy.m_clusterOf.size() == nodes && valuesInRange(hierarchy.m_clusterOf, 0, clusters) &&
+                hierarchy.m_abstractIndex.size() == nodes && valuesInRange(hierarchy.m_abstractIndex, -1, entrances) &&
+                valuesInRange(hierarchy.m_entranceNodes, 0, nodes) &&
+                validOffsets(hierarchy.m_clusterEntranceOffsets, clusters, hierarchy.m_clusterEntrances) &&
+                valuesInRange(hierarchy.m_clusterEntrances, 0, entrances) &&
+                validOffsets(hierarchy.m_abstractOffsets, entrances, hierarchy.m_abstractTargets) &&
+                hierarchy.m_abstractCosts.size() == hierarchy.m_abstractTargets.size() &&
+                validCosts(hierarchy.m_abstractCosts) &&
+                valuesInRange(hierarchy.m_abstractTargets, 0, entrances);
+    }
+
+    if (!valid) {
+        std::cerr << "[LevelCache] Navigation section is malformed; rebuilding" << std::endl;
+        graph.reset();
+        return false;
+    }
+    return true;
+}
@@ -2,6 +2,7 @@
 #include "Game.h"
 #include "ModelLoader.h"
 #include "Settings.h"
+#include "Systems/RaycastUtility.h"
 #include <iostream>
 #include <limits>
 #include <glm/gtc/matrix_transform.hpp>
@@ -53,7 +54,12 @@ LevelManager::LevelManager(Game& game) : m_game(game) {}
 LevelManager::~LevelManager() {}
 
 bool LevelManager::loadLevel(int levelIndex) {
-    m_currentLevelPath = "assets/levels/level_" + std::to_string(levelIndex) + ".glb";
+    m_currentLevelPath = getLevelFilePath(levelIndex, ".glb");
+    m_currentCachePath = getLevelFilePath(levelIndex, ".nav");
+    m_hasSourceHash = false;
+    m_levelCache.clear();
+    m_cachedBVHs.clear();
+    m_collisionMeshCount = 0;
     
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile(m_currentLevelPath, 
@@ -70,14 +76,26 @@ bool LevelManager::loadLevel(int levelIndex) {
     m_game.enemies.clear();
     m_game.player.reset();
     m_levelMeshes.clear();
-    m_levelMeshTransforms.clear();
 
     if (m_game.projectiles.size() > 0) m_game.projectiles.clear();
     if (m_game.weaponPickups.size() > 0) m_game.weaponPickups.clear();
     m_pendingSpawns.clear();
 
+    // Derived collision and navigation data is reused while the .glb is unchanged
+    m_hasSourceHash = LevelCache::hashFile(m_currentLevelPath, m_sourceHash);
+    if (m_hasSourceHash && m_levelCache.load(m_currentCachePath, m_sourceHash)) {
+        std::cout << "LevelManager: Using level cache " << m_currentCachePath << " ("
+                  << m_levelCache.getSizeBytes() / 1024 << " KB)" << std::endl;
+        m_levelCache.restoreCollisionBVHs(m_cachedBVHs);
+    }
+
     std::cout << "LevelManager: Processing level " << m_currentLevelPath << "..." << std::endl;
     processNode(scene->mRootNode, scene, glm::mat4(1.0f));
+    m_cachedBVHs.clear();
+    Mesh::MemoryStats meshMemory = Mesh::getMemoryStats(MeshCategory::Level);
+    std::cout << "LevelManager: " << meshMemory.meshCount << " level meshes, " << meshMemory.gpuBytes / 1024
+              << " KB on the GPU, " << meshMemory.cpuBytes / 1024 << " KB kept on the CPU" << std::endl;
+    buildBroadphase();
     
     // Resolve ground heights for all spawns
     resolveSpawns();
@@ -150,9 +168,41 @@ bool LevelManager::loadLevel(int levelIndex) {
     return true;
 }
 
+std::string LevelManager::getLevelFilePath(int levelIndex, const std::string& extension) {
+    return "assets/levels/level_" + std::to_string(levelIndex) + extension;
+}
+
+bool LevelManager::restoreNavigation(NavigationGraph& graph) {
+    bool restored = m_levelCache.isLoaded() && m_levelCache.restoreNavigation(graph);
+    m_levelCache.clear();
+    return restored;
+}
+
+void LevelManager::saveLevelCache(const NavigationGraph& graph) {
+    if (!m_hasSourceHash) {
+        return; // Fallback level: nothing on disk to key the cache to
+    }
+    if (LevelCache::save(m_currentCachePath, m_sourceHash, m_game.platforms, m_game.platformTree, graph)) {
+        std::cout << "LevelManager: Wrote level cache " << m_currentCachePath << std::endl;
+    }
+}
+
+void LevelManager::getLevelTriangles(std::vector<glm::vec3>& outTriangles) const {
+    outTriangles.clear();
+    // Render meshes drop their CPU copies after upload; the cooked collision meshes are already in world space
+    for (const Platform& platform : m_game.platforms) {
+        if (!platform.hasCollisionMesh()) continue;
+        for (const TriangleBVH::Triangle& tri : platform.getCollisionMesh().getBVH().getTriangles()) {
+            outTriangles.push_back(tri.v0);
+            outTriangles.push_back(tri.v1);
+            outTriangles.push_back(tri.v2);
+        }
+    }
+}
+
 bool LevelManager::levelExists(int levelIndex) {
     if (levelIndex == 0) return false; // 0 is invalid or test level, usually we start at 1
-    std::string path = "assets/levels/level_" + std::to_string(levelIndex) + ".glb";
+    std::string path = getLevelFilePath(levelIndex, ".glb");
     
     // Check if file exists
     std::ifstream f(path.c_str());
@@ -161,6 +211,7 @@ bool LevelManager::levelExists(int levelIndex) {
 
 void LevelManager::loadHardcodedFallback() {
     m_game.platforms.clear();
+    m_levelMeshes.clear();
     m_game.platforms.emplace_back(glm::vec3(0.0f, -0.25f, 0.0f), glm::vec3(50.0f, 0.5f, 50.0f));
     m_game.platforms.emplace_back(glm::vec3(5.0f, 1.0f, -5.0f), glm::vec3(4.0f, 0.5f, 4.0f));
     m_game.platforms.emplace_back(glm::vec3(-6.0f, 1.5f, 3.0f), glm::vec3(3.0f, 0.5f, 3.0f));
@@ -171,6 +222,7 @@ void LevelManager::loadHardcodedFallback() {
     m_game.platforms.emplace_back(glm::vec3(0.0f, 2.0f, 15.0f), glm::vec3(30.0f, 4.0f, 1.0f));
     m_game.platforms.emplace_back(glm::vec3(-15.0f, 2.0f, 0.0f), glm::vec3(1.0f, 4.0f, 30.0f));
     m_game.platforms.emplace_back(glm::vec3(15.0f, 2.0f, 0.0f), glm::vec3(1.0f, 4.0f, 30.0f));
+    buildBroadphase();
 
     m_game.enemies.clear();
     m_game.enemies.emplace_back(glm::vec3(10.0f, 1.0f, 5.0f));
@@ -246,43 +298,81 @@ void LevelManager::handleObject(const SceneObject& obj, aiNode* node, const aiSc
         // Any object with geometry automatically becomes a platform for collision
         m_game.platforms.emplace_back(obj.position, obj.size, nullptr, transform, name);
         Platform& platform = m_game.platforms.back();
+
+        // Collision is cooked once per platform in world space; the level cache may already have it
+        size_t collisionSlot = m_collisionMeshCount++;
+        bool cached = collisionSlot < m_cachedBVHs.size();
+        CollisionMesh collisionMesh = cached ? CollisionMesh(std::move(m_cachedBVHs[collisionSlot])) : CollisionMesh();
         
         for (unsigned int i = 0; i < node->mNumMeshes; i++) {
             aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-            auto newMesh = ModelLoader::processMesh(mesh, scene);
+            // The CPU copy is only kept long enough to cook collision from it
+            auto newMesh = ModelLoader::processMesh(mesh, scene, MeshCategory::Level,
+                                                    cached ? MeshCpuData::Release : MeshCpuData::Keep);
             
-            // Add mesh to platform for rendering and narrow collision
-            platform.getMeshes().push_back(newMesh.get());
+            if (!cached) {
+                collisionMesh.addTriangles(newMesh->vertices, newMesh->indices, transform);
+                newMesh->releaseCpuData();
+            }
+            platform.addMesh(newMesh.get());
 
             m_levelMeshes.push_back(std::move(newMesh));
-            m_levelMeshTransforms.push_back(transform);
         }
+
+        if (!cached) {
+            collisionMesh.cook();
+            if (collisionMesh.getDroppedCount() > 0) {
+                std::cout << "  - Dropped " << collisionMesh.getDroppedCount() << " degenerate collision triangles from '"
+                          << name << "'" << std::endl;
+            }
+        }
+        platform.setCollisionMesh(std::move(collisionMesh));
         
         std::cout << "  - Created Platform '" << name << "' at (" << obj.position.x << "," << obj.position.y << "," << obj.position.z 
                   << ") size (" << obj.size.x << "," << obj.size.y << "," << obj.size.z << ") with " << platform.getMeshes().size() << " meshes" << std::endl;
     }
 }
 
+void LevelManager::buildBroadphase() {
+    if (m_levelCache.restoreBroadphase(m_game.platformTree, m_game.platforms.size()) &&
+        m_game.platformTree.getProxyCount() == static_cast<int>(m_game.platforms.size())) {
+        std::cout << "LevelManager: Broadphase restored from cache (" << m_game.platformTree.getProxyCount()
+                  << " platforms)" << std::endl;
+        return;
+    }
+
+    // Platforms are static once loaded, so the tree is rebuilt from scratch per level
+    m_game.platformTree.clear();
+    for (size_t i = 0; i < m_game.platforms.size(); ++i) {
+        const Platform& p = m_game.platforms[i];
+        m_game.platformTree.createProxy(p.getPosition() - p.getSize() * 0.5f, p.getPosition() + p.getSize() * 0.5f, static_cast<int>(i));
+    }
+    std::cout << "LevelManager: Broadphase built over " << m_game.platformTree.getProxyCount()
+              << " platforms (height " << m_game.platformTree.getHeight() << ")" << std::endl;
+}
+
 void LevelManager::resolveSpawns() {
     std::cout << "LevelManager: Resolving ground heights for " << m_pendingSpawns.size() << " spawns..." << std::endl;
     
+    // Raycast from high up to find the actual floor under every spawn in one batch.
+    // The rays point straight down, so the nearest hit is the highest surface.
+    std::vector<RaycastUtility::Ray> rays;
+    rays.reserve(m_pendingSpawns.size());
     for (const auto& spawn : m_pendingSpawns) {
-        // Raycast from high up to find the actual floor at this spot
-        glm::vec3 rayOrigin(spawn.position.x, 100.0f, spawn.position.z);
-        glm::vec3 rayDir(0.0f, -1.0f, 0.0f);
+        rays.push_back({glm::vec3(spawn.position.x, 100.0f, spawn.position.z), glm::vec3(0.0f, -1.0f, 0.0f), 200.0f});
+    }
+    std::vector<RaycastUtility::RaycastHit> hits;
+    RaycastUtility::raycastPlatformsBatch(rays, hits, m_game.platforms, &m_game.platformTree);
+
+    for (size_t spawnIndex = 0; spawnIndex < m_pendingSpawns.size(); ++spawnIndex) {
+        const auto& spawn = m_pendingSpawns[spawnIndex];
+        glm::vec3 rayOrigin = rays[spawnIndex].origin;
         float bestY = -100.0f;
-        bool foundFloor = false;
-
-        for (const auto& platform : m_game.platforms) {
-            float t = platform.raycast(rayOrigin, rayDir, 200.0f);
-            if (t >= 0.0f) {
-                float hitY = rayOrigin.y - t;
-                // We prefer the highest surface that is roughly near or above our marker
-                if (!foundFloor || hitY > bestY) {
-                    bestY = hitY;
-                    foundFloor = true;
-                }
-            }
+
+        const RaycastUtility::RaycastHit& hit = hits[spawnIndex];
+        bool foundFloor = hit.hit;
+        if (foundFloor) {
+            bestY = rayOrigin.y - hit.distance;
         }
 
         // Use the found floor height, or try to align to a nearby platform top if none found
@@ -295,29 +385,26 @@ void LevelManager::resolveSpawns() {
             // No mesh hit; try to find a platform whose XZ AABB contains the spawn marker and use its top
             float bestPlatformTop = std::numeric_limits<float>::lowest();
             bool foundPlatform = false;
-            for (const auto& platform : m_game.platforms) {
-                glm::vec3 pmin = platform.getPosition() - platform.getSize() * 0.5f;
-                glm::vec3 pmax = platform.getPosition() + platform.getSize() * 0.5f;
-                if (spawn.position.x >= pmin.x - 0.01f && spawn.position.x <= pmax.x + 0.01f &&
-                    spawn.position.z >= pmin.z - 0.01f && spawn.position.z <= pmax.z + 0.01f) {
-                    float top = platform.getPosition().y + platform.getSize().y * 0.5f;
-                    if (top > bestPlatformTop) {
-                        bestPlatformTop = top;
-                        foundPlatform = true;
-                    }
+            glm::vec3 columnMin(spawn.position.x - 0.01f, std::numeric_limits<float>::lowest(), spawn.position.z - 0.01f);
+            glm::vec3 columnMax(spawn.position.x + 0.01f, std::numeric_limits<float>::max(), spawn.position.z + 0.01f);
+            m_game.platformTree.query(columnMin, columnMax, [&](int index) {
+                const Platform& platform = m_game.platforms[index];
+                float top = platform.getPosition().y + platform.getSize().y * 0.5f;
+                if (top > bestPlatformTop) {
+                    bestPlatformTop = top;
+                    foundPlatform = true;
                 }
-            }
+                return true;
+            });
 
             if (foundPlatform) {
                 resolvedY = bestPlatformTop;
                 std::cout << "  - Spawn '" << spawn.name << "' aligned to platform top at " << resolvedY << std::endl;
             } else {
                 // As a last resort, clamp extremely high spawn markers down to the highest platform top
-                float highestTop = std::numeric_limits<float>::lowest();
-                for (const auto& platform : m_game.platforms) {
-                    float top = platform.getPosition().y + platform.getSize().y * 0.5f;
-                    highestTop = std::max(highestTop, top);
-                }
+                // The broadphase root bounds are exactly the union of all platform AABBs
+                float highestTop = m_game.platformTree.empty() ? std::numeric_limits<float>::lowest()
+                                                               : m_game.platformTree.getBoundsMax().y;
                 if (highestTop > std::numeric_limits<float>::lowest() && spawn.position.y > highestTop + 2.0f) {
                     resolvedY = highestTop;
                     std::cout << "  - Spawn '" << spawn.name << "' dropped to highest platform top " << resolvedY << " (was " << spawn.position.y << ")" << std::endl;
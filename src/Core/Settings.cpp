@@ -33,6 +33,7 @@ Settings::Settings() {
     graphics.gammaCorrection = true;
     graphics.techStyleIntensity = 0.6f;
     graphics.showFPS = false;
+    graphics.gpuParticles = false;
 }
 
 bool Settings::load(const std::string& filepath) {
@@ -73,6 +74,7 @@ bool Settings::load(const std::string& filepath) {
                 else if (key == "graphics.gamma") graphics.gammaCorrection = (std::stoi(value) != 0);
                 else if (key == "graphics.techstyle") graphics.techStyleIntensity = std::stof(value);
                 else if (key == "graphics.showfps") graphics.showFPS = (std::stoi(value) != 0);
+                else if (key == "graphics.gpuparticles") graphics.gpuParticles = (std::stoi(value) != 0);
 
                 // Input
                 else if (key == "input.sensitivity") input.mouseSensitivity = std::stof(value);
@@ -123,6 +125,7 @@ void Settings::save(const std::string& filepath) const {
     file << "graphics.gamma=" << (graphics.gammaCorrection ? 1 : 0) << "\n";
     file << "graphics.techstyle=" << graphics.techStyleIntensity << "\n";
     file << "graphics.showfps=" << (graphics.showFPS ? 1 : 0) << "\n";
+    file << "graphics.gpuparticles=" << (graphics.gpuParticles ? 1 : 0) << "\n";
 
     file << "\n[Input]\n";
     file << "input.sensitivity=" << input.mouseSensitivity << "\n";
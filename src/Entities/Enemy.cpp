@@ -1,12 +1,15 @@
 #include "Enemy.h"
 #include "Entities/Platform.h"
 #include "Systems/NavigationGraph.h"
-#include "Systems/RaycastUtility.h"
+#include "Systems/FlowField.h"
+#include "Systems/PathRequestService.h"
+#include "Systems/AABBTree.h"
 #include "Systems/AudioSystem.h"
 #include "Config.h"
 #include <glm/gtx/norm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
+#include <numeric>
 
 Enemy::Enemy(glm::vec3 position, WeaponType weaponType)
     : position(position),
@@ -28,7 +31,11 @@ Enemy::Enemy(glm::vec3 position, WeaponType weaponType)
       alertedDuration(3.0f),
       currentWaypointIndex(0),
       pathRecalculateTimer(0.0f),
-      pathRecalculateInterval(0.5f) {
+      pathRecalculateInterval(0.5f),
+      pendingPathTicket(0),
+      simplifiedPhysics(false),
+      sleeping(false),
+      restTime(0.0f) {
     
     // Initialize enemy weapon
     auto config = Config::Weapon::getWeaponConfig(weaponType);
@@ -40,9 +47,13 @@ Enemy::Enemy(glm::vec3 position, WeaponType weaponType)
     );
 }  
 
-void Enemy::update(float deltaTime, glm::vec3 playerPosition,
+void Enemy::update(float deltaTime, glm::vec3 playerPosition, bool playerInSight,
                    const NavigationGraph* navGraph,
+                   const FlowField* flowField,
+                   PathRequestService* pathService,
+                   int pathRequesterId,
                    const std::vector<Platform>& platforms,
+                   const AABBTree* platformTree,
                    AudioSystem* audio) {
     if (!isAlive()) {
         return;
@@ -53,7 +64,7 @@ void Enemy::update(float deltaTime, glm::vec3 playerPosition,
     float distanceToPlayer = glm::length(toPlayer);
     
     // Check if can see player
-    bool canSee = distanceToPlayer < detectionRange && checkLineOfSight(playerPosition, platforms);
+    bool canSee = distanceToPlayer < detectionRange && playerInSight;
     
     if (canSee) {
         hasSeenPlayer = true;
@@ -104,10 +115,10 @@ void Enemy::update(float deltaTime, glm::vec3 playerPosition,
     }
     
     // Update movement and pathfinding (uses lastSeenPosition if we recently saw the player)
-    updateMovement(deltaTime, playerPosition, navGraph, platforms);
+    updateMovement(deltaTime, playerPosition, playerInSight, navGraph, flowField, pathService, pathRequesterId);
     
     // Apply physics (gravity, collision)
-    applyPhysics(deltaTime, platforms);
+    applyPhysics(deltaTime, platforms, platformTree);
 } 
 
 bool Enemy::shouldShoot(float currentTime) const {
@@ -134,6 +145,7 @@ void Enemy::shoot(float /*currentTime*/) {
 }
 
 void Enemy::takeDamage(float damage) {
+    wake();
     health -= damage;
     if (health < 0.0f) {
         health = 0.0f;
@@ -145,9 +157,11 @@ bool Enemy::canSeePlayer(glm::vec3 playerPosition) const {
     return isAlive() && distance < detectionRange;
 }
 
-void Enemy::updateMovement(float deltaTime, glm::vec3 playerPosition,
+void Enemy::updateMovement(float deltaTime, glm::vec3 playerPosition, bool hasLOS,
                            const NavigationGraph* navGraph,
-                           const std::vector<Platform>& platforms) {
+                           const FlowField* flowField,
+                           PathRequestService* pathService,
+                           int pathRequesterId) {
     if (!navGraph || !navGraph->isValid()) {
         static bool printed = false;
         if (!printed) {
@@ -173,7 +187,6 @@ void Enemy::updateMovement(float deltaTime, glm::vec3 playerPosition,
     }
     
     float distanceToPlayer = glm::length(playerPosition - position);
-    bool hasLOS = checkLineOfSight(playerPosition, platforms);
     
     float range = weapon ? weapon->getRange() : 10.0f;
     static int debugCounter2 = 0;
@@ -204,20 +217,52 @@ void Enemy::updateMovement(float deltaTime, glm::vec3 playerPosition,
         
         // Clear path since we're doing direct chase
         currentPath.clear();
+        abstractPath.clear();
         return;
     }
     
     // Player not visible, use pathfinding
-    pathRecalculateTimer += deltaTime;
-    if (pathRecalculateTimer >= pathRecalculateInterval) {
-        pathRecalculateTimer = 0.0f;
-        glm::vec3 target = hasSeenPlayer ? lastSeenPosition : playerPosition;
-        currentPath = navGraph->findPath(position, target);
+    glm::vec3 target = hasSeenPlayer ? lastSeenPosition : playerPosition;
+    
+    // The shared flow field answers for any target on the same nav node as the player
+    if (flowField && flowField->isValid() && navGraph->getClosestNode(target) == flowField->getTargetNode()) {
+        currentPath.clear();
+        abstractPath.clear();
         currentWaypointIndex = 0;
+        pendingPathTicket = 0;
+        followFlowField(navGraph, flowField, target);
+    } else {
+        pathRecalculateTimer += deltaTime;
+        if (pathRecalculateTimer >= pathRecalculateInterval) {
+            pathRecalculateTimer = 0.0f;
+            // Large graph: search clusters and only refine the first few segments
+            bool hierarchical = navGraph->hasHierarchy() && !navGraph->hasNextHopTable();
+            if (pathService) {
+                // Keep following (and refining) the current path until the new one arrives
+                pendingPathTicket = pathService->request(pathRequesterId, position, target,
+                    hierarchical ? PathRequestService::RequestType::Hierarchical : PathRequestService::RequestType::Full);
+            } else if (hierarchical) {
+                currentPath.clear();
+                currentWaypointIndex = 0;
+                if (navGraph->getHierarchy().findPath(position, target, abstractPath)) {
+                    navGraph->getHierarchy().refine(abstractPath, Config::NAV_REFINE_LOOKAHEAD, currentPath);
+                }
+            } else {
+                abstractPath.clear();
+                currentPath = navGraph->findPath(position, target);
+                currentWaypointIndex = 0;
+            }
+        }
+        
+        // Refine more of the cluster route before running out of waypoints
+        if (!abstractPath.finished && navGraph->hasHierarchy() &&
+            currentWaypointIndex + 2 >= static_cast<int>(currentPath.size())) {
+            navGraph->getHierarchy().refine(abstractPath, Config::NAV_REFINE_LOOKAHEAD, currentPath);
+        }
+        
+        // Follow the path
+        followPath(deltaTime);
     }
-    
-    // Follow the path
-    followPath(deltaTime);
 
     // If we were chasing towards the last seen position and we've reached it, stop chasing
     if (hasSeenPlayer) {
@@ -228,10 +273,21 @@ void Enemy::updateMovement(float deltaTime, glm::vec3 playerPosition,
             velocity.x = 0.0f;
             velocity.z = 0.0f;
             currentPath.clear();
+            abstractPath.clear();
         }
     }
 }
 
+void Enemy::onPathReady(uint32_t ticket, std::vector<glm::vec3>&& path, HierarchicalPathfinder::Path&& route) {
+    if (ticket == 0 || ticket != pendingPathTicket) {
+        return;
+    }
+    pendingPathTicket = 0;
+    abstractPath = std::move(route);
+    currentPath = std::move(path);
+    currentWaypointIndex = 0;
+}
+
 void Enemy::followPath(float /*deltaTime*/) {
     if (currentPath.empty() || currentWaypointIndex >= static_cast<int>(currentPath.size())) {
         velocity.x = 0.0f;
@@ -270,22 +326,70 @@ void Enemy::followPath(float /*deltaTime*/) {
     }
 }
 
-void Enemy::applyPhysics(float deltaTime, const std::vector<Platform>& platforms) {
+void Enemy::followFlowField(const NavigationGraph* navGraph, const FlowField* flowField, glm::vec3 target) {
+    int node = navGraph->getClosestNode(position);
+    int nextNode = flowField->getNextNode(node);
+    
+    // Already on the target's node: head straight for the target. Unreachable: stand still.
+    glm::vec3 waypoint = target;
+    if (node != flowField->getTargetNode()) {
+        if (nextNode == -1) {
+            velocity.x = 0.0f;
+            velocity.z = 0.0f;
+            return;
+        }
+        waypoint = navGraph->getNodes()[nextNode].position;
+    }
+    
+    glm::vec3 toWaypoint = waypoint - position;
+    toWaypoint.y = 0.0f; // Only move horizontally
+    
+    float distanceToWaypoint = glm::length(toWaypoint);
+    if (distanceToWaypoint > 0.1f) {
+        glm::vec3 direction = toWaypoint / distanceToWaypoint;
+        velocity.x = direction.x * moveSpeed;
+        velocity.z = direction.z * moveSpeed;
+    } else {
+        velocity.x = 0.0f;
+        velocity.z = 0.0f;
+    }
+}
+
+void Enemy::applyPhysics(float deltaTime, const std::vector<Platform>& platforms, const AABBTree* platformTree) {
+    // A sleeping body stays put until the AI wants to move it
+    if (sleeping) {
+        if (velocity.x == 0.0f && velocity.z == 0.0f) {
+            return;
+        }
+        wake();
+    }
+
     // Apply gravity to velocity
     velocity.y -= Config::GRAVITY * deltaTime;
 
     // Sub-stepping to prevent tunneling through floors during lag or high speed
-    const int SUB_STEPS = 4;
+    // A resting enemy on a reduced AI tier only needs one step to stay on its floor
+    const int SUB_STEPS = (simplifiedPhysics && onGround && velocity.x == 0.0f && velocity.z == 0.0f) ? 1 : 4;
     float subDeltaTime = deltaTime / static_cast<float>(SUB_STEPS);
 
+    // Broadphase: gather the platforms near this frame's swept box once, then reuse them for every substep
+    if (platformTree) {
+        glm::vec3 endPos = position + velocity * deltaTime;
+        glm::vec3 extent = size * 0.5f + glm::vec3(Config::BROADPHASE_MARGIN);
+        platformTree->queryUserData(glm::min(position, endPos) - extent, glm::max(position, endPos) + extent, nearbyPlatforms);
+    } else {
+        nearbyPlatforms.resize(platforms.size());
+        std::iota(nearbyPlatforms.begin(), nearbyPlatforms.end(), 0);
+    }
+
     for (int step = 0; step < SUB_STEPS; step++) {
         // Update position
         position += velocity * subDeltaTime;
         
         // Check collisions with platforms using the unified CheckCollision logic
         onGround = false;
-        for (auto& platform : const_cast<std::vector<Platform>&>(platforms)) {
-            if (platform.checkCollision(position, size, velocity)) {
+        for (int index : nearbyPlatforms) {
+            if (const_cast<Platform&>(platforms[index]).checkCollision(position, size, velocity)) {
                 onGround = true;
             }
         }
@@ -297,13 +401,19 @@ void Enemy::applyPhysics(float deltaTime, const std::vector<Platform>& platforms
             break;
         }
     }
+
+    // Grounded with no velocity left after collision: fall asleep once that has lasted a while
+    if (onGround && velocity == glm::vec3(0.0f)) {
+        restTime += deltaTime;
+        sleeping = restTime >= Config::ENEMY_SLEEP_DELAY;
+    } else {
+        restTime = 0.0f;
+    }
 }
 
-bool Enemy::checkLineOfSight(glm::vec3 playerPosition, const std::vector<Platform>& platforms) const {
-    glm::vec3 eyePos = position + glm::vec3(0.0f, Config::EYE_HEIGHT, 0.0f);
-    glm::vec3 playerEyePos = playerPosition + glm::vec3(0.0f, Config::EYE_HEIGHT, 0.0f);
-    
-    return RaycastUtility::hasLineOfSight(eyePos, playerEyePos, platforms);
+void Enemy::wake() {
+    sleeping = false;
+    restTime = 0.0f;
 }
 
 bool Enemy::isAlerted() const {
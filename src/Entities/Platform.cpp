@@ -5,6 +5,7 @@
 #include <iostream>
 #include <string>
 #include <cctype>
+#include <utility>
 
 #include "Renderer/Mesh.h"
 #include "Systems/RaycastUtility.h"
@@ -13,7 +14,11 @@ Platform::Platform(glm::vec3 position, glm::vec3 size, const Mesh* mesh, const g
     : position(position), size(size), m_transform(transform), m_name(name) {
     
     if (mesh) {
-        m_meshes.push_back(mesh);
+        addMesh(mesh);
+        CollisionMesh collisionMesh;
+        collisionMesh.addTriangles(mesh->vertices, mesh->indices, transform);
+        collisionMesh.cook();
+        setCollisionMesh(std::move(collisionMesh));
     }
     
     // Detect if this platform is intended to be ground/floor
@@ -26,8 +31,19 @@ Platform::Platform(glm::vec3 position, glm::vec3 size, const Mesh* mesh, const g
                  size.x > 10.0f || size.z > 10.0f); // Robust fallback for huge surfaces
 }
 
+void Platform::addMesh(const Mesh* mesh) {
+    if (!mesh) return;
+
+    m_meshes.push_back(mesh);
+}
+
+void Platform::setCollisionMesh(CollisionMesh&& collisionMesh) {
+    m_collisionMesh = std::move(collisionMesh);
+    m_hasCollisionMesh = true;
+}
+
 float Platform::getSurfaceHeight(glm::vec3 xzPos, float currentY) const {
-    if (m_meshes.empty()) {
+    if (!m_hasCollisionMesh) {
         return position.y + size.y / 2.0f;
     }
 
@@ -35,47 +51,9 @@ float Platform::getSurfaceHeight(glm::vec3 xzPos, float currentY) const {
     glm::vec3 rayOrigin(xzPos.x, currentY + 2.0f, xzPos.z);
     glm::vec3 rayDir(0.0f, -1.0f, 0.0f);
 
-    // Transform ray to model space for intersection
-    glm::mat4 invTransform = glm::inverse(m_transform);
-    glm::vec3 localOrigin = glm::vec3(invTransform * glm::vec4(rayOrigin, 1.0f));
-    glm::vec3 localDir = glm::vec3(invTransform * glm::vec4(rayDir, 0.0f));
-
-    float closestT = std::numeric_limits<float>::max();
-    bool hit = false;
-
-    for (const Mesh* m_mesh : m_meshes) {
-        if (!m_mesh) continue;
-        const std::vector<Vertex>& verts = m_mesh->vertices;
-        const std::vector<unsigned int>& indices = m_mesh->indices;
-        
-        if (indices.empty() || verts.empty()) continue;
-
-        for (size_t i = 0; i < indices.size(); i += 3) {
-            if (i + 2 >= indices.size()) break;
-            
-            if (indices[i] >= verts.size() || indices[i+1] >= verts.size() || indices[i+2] >= verts.size()) {
-                 // std::cerr << "Mesh collision index out of bounds!" << std::endl;
-                 continue;
-            }
-
-            glm::vec3 v0 = verts[indices[i]].Position;
-            glm::vec3 v1 = verts[indices[i+1]].Position;
-            glm::vec3 v2 = verts[indices[i+2]].Position;
-
-            float t;
-            if (RaycastUtility::rayTriangleIntersection(localOrigin, localDir, v0, v1, v2, t)) {
-                if (t < closestT) {
-                    closestT = t;
-                    hit = true;
-                }
-            }
-        }
-    }
-
-    if (hit) {
-        glm::vec3 localHit = localOrigin + localDir * closestT;
-        glm::vec3 worldHit = glm::vec3(m_transform * glm::vec4(localHit, 1.0f));
-        return worldHit.y;
+    float t;
+    if (m_collisionMesh.raycast(rayOrigin, rayDir, std::numeric_limits<float>::max(), t)) {
+        return rayOrigin.y - t;
     }
 
     // If no mesh hit (e.g. off the edge of the geometry but inside AABB), fall back to AABB bottom to avoid sticking? 
@@ -99,7 +77,7 @@ bool Platform::checkCollision(glm::vec3& playerPos, glm::vec3 playerSize, glm::v
     }
 
     // 2. Narrow Phase
-    if (!m_meshes.empty()) {
+    if (m_hasCollisionMesh) {
         // Find the precise mesh surface at the player's XZ location
         float exactHeight = getSurfaceHeight(playerPos, playerPos.y);
         
@@ -197,40 +175,12 @@ bool Platform::checkRayCollision(const glm::vec3& start, const glm::vec3& end) c
     if (tMin > dist) return false;
 
     // 2. Narrow Phase (Ray-Mesh)
-    if (m_meshes.empty()) {
+    if (!m_hasCollisionMesh) {
         // For standard platforms, AABB hit is enough
         return true;
     }
 
-    // Transform ray to model space
-    glm::mat4 invTransform = glm::inverse(m_transform);
-    glm::vec3 localOrigin = glm::vec3(invTransform * glm::vec4(start, 1.0f));
-    glm::vec3 localDir = glm::vec3(invTransform * glm::vec4(dir, 0.0f));
-    float localDist = glm::length(glm::vec3(invTransform * glm::vec4(dir * dist, 0.0f)));
-    localDir = glm::normalize(localDir);
-
-    for (const Mesh* m_mesh : m_meshes) {
-        if (!m_mesh) continue;
-        const std::vector<Vertex>& verts = m_mesh->vertices;
-        const std::vector<unsigned int>& indices = m_mesh->indices;
-
-        for (size_t i = 0; i < indices.size(); i += 3) {
-            if (i + 2 >= indices.size()) break;
-            
-            if (indices[i] >= verts.size() || indices[i+1] >= verts.size() || indices[i+2] >= verts.size()) continue;
-
-            glm::vec3 v0 = verts[indices[i]].Position;
-            glm::vec3 v1 = verts[indices[i+1]].Position;
-            glm::vec3 v2 = verts[indices[i+2]].Position;
-
-            float hitT;
-            if (RaycastUtility::rayTriangleIntersection(localOrigin, localDir, v0, v1, v2, hitT)) {
-                if (hitT <= localDist) return true;
-            }
-        }
-    }
-
-    return false;
+    return m_collisionMesh.raycastAny(start, dir, dist);
 }
 
 float Platform::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
@@ -246,43 +196,13 @@ float Platform::raycast(const glm::vec3& origin, const glm::vec3& direction, flo
     if (tMin > maxDistance) return -1.0f;
 
     // 2. Narrow Phase (Ray-Mesh)
-    if (m_meshes.empty()) {
+    if (!m_hasCollisionMesh) {
         return (tMin >= 0.0f) ? tMin : 0.0f;
     }
 
-    // Transform ray to model space
-    glm::mat4 invTransform = glm::inverse(m_transform);
-    glm::vec3 localOrigin = glm::vec3(invTransform * glm::vec4(origin, 1.0f));
-    glm::vec3 localDir = glm::vec3(invTransform * glm::vec4(direction, 0.0f));
-    float scale = glm::length(localDir);
-    if (scale > 0.0001f) localDir /= scale;
-
-    float closestT = std::numeric_limits<float>::max();
-    bool hit = false;
-
-    for (const Mesh* m_mesh : m_meshes) {
-        if (!m_mesh) continue;
-        const std::vector<Vertex>& verts = m_mesh->vertices;
-        const std::vector<unsigned int>& indices = m_mesh->indices;
-
-        for (size_t i = 0; i < indices.size(); i += 3) {
-            if (i + 2 >= indices.size()) break;
-            if (indices[i] >= verts.size() || indices[i+1] >= verts.size() || indices[i+2] >= verts.size()) continue;
-
-            float t;
-            if (RaycastUtility::rayTriangleIntersection(localOrigin, localDir, verts[indices[i]].Position, 
-                                                       verts[indices[i+1]].Position, verts[indices[i+2]].Position, t)) {
-                if (t < closestT) {
-                    closestT = t;
-                    hit = true;
-                }
-            }
-        }
-    }
-
-    if (hit) {
-        float worldT = closestT / scale;
-        if (worldT <= maxDistance) return worldT;
+    float t;
+    if (m_collisionMesh.raycast(origin, direction, maxDistance, t)) {
+        return t;
     }
 
     return -1.0f;
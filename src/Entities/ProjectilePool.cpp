@@ -0,0 +1,32 @@
+#include "ProjectilePool.h"
+#include <utility>
+
+ProjectilePool::ProjectilePool(size_t capacity)
+    : m_capacity(capacity), m_highWaterMark(0), m_droppedCount(0) {
+    m_projectiles.reserve(capacity);
+}
+
+Projectile* ProjectilePool::spawn(glm::vec3 position, glm::vec3 direction, float speed, float damage, float lifetime, bool isEnemy) {
+    if (m_projectiles.size() >= m_capacity) {
+        ++m_droppedCount;
+        return nullptr;
+    }
+
+    m_projectiles.emplace_back(position, direction, speed, damage, lifetime, isEnemy);
+    if (m_projectiles.size() > m_highWaterMark) {
+        m_highWaterMark = m_projectiles.size();
+    }
+    return &m_projectiles.back();
+}
+
+ProjectilePool::iterator ProjectilePool::despawn(iterator it) {
+    iterator last = m_projectiles.end() - 1;
+    if (it == last) {
+        // pop_back invalidates iterators to the removed element
+        m_projectiles.pop_back();
+        return m_projectiles.end();
+    }
+    *it = std::move(*last);
+    m_projectiles.pop_back();
+    return it;
+}
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <cmath>
+#include <utility>
 #include <glm/glm.hpp>
 
 namespace GeometryFactory {
@@ -43,7 +44,7 @@ std::unique_ptr<Mesh> createCube() {
         20, 21, 22, 22, 23, 20
     };
 
-    return std::make_unique<Mesh>(vertices, indices);
+    return std::make_unique<Mesh>(std::move(vertices), std::move(indices), MeshCategory::Primitive);
 }
 
 std::unique_ptr<Mesh> createSphere(int segments, int rings) {
@@ -87,7 +88,7 @@ std::unique_ptr<Mesh> createSphere(int segments, int rings) {
         }
     }
 
-    return std::make_unique<Mesh>(vertices, indices);
+    return std::make_unique<Mesh>(std::move(vertices), std::move(indices), MeshCategory::Primitive);
 }
 
 std::unique_ptr<Mesh> createTorus(float majorRadius, float minorRadius, int segments, int rings) {
@@ -137,7 +138,7 @@ std::unique_ptr<Mesh> createTorus(float majorRadius, float minorRadius, int segm
         }
     }
 
-    return std::make_unique<Mesh>(vertices, indices);
+    return std::make_unique<Mesh>(std::move(vertices), std::move(indices), MeshCategory::Primitive);
 }
 
 std::unique_ptr<Mesh> createPlane(float size) {
@@ -155,7 +156,7 @@ std::unique_ptr<Mesh> createPlane(float size) {
         2, 3, 0
     };
 
-    return std::make_unique<Mesh>(vertices, indices);
+    return std::make_unique<Mesh>(std::move(vertices), std::move(indices), MeshCategory::Primitive);
 }
 
 std::unique_ptr<Mesh> createQuad() {
@@ -169,7 +170,7 @@ std::unique_ptr<Mesh> createQuad() {
         0, 1, 2,
         0, 2, 3
     };
-    return std::make_unique<Mesh>(vertices, indices);
+    return std::make_unique<Mesh>(std::move(vertices), std::move(indices), MeshCategory::Primitive);
 }
 
 std::unique_ptr<Mesh> createWeaponMesh() {
@@ -249,7 +250,7 @@ std::unique_ptr<Mesh> createWeaponMesh() {
     // Magazine (mag well)
     addBox(glm::vec3(0.0f, -0.3f, -0.25f), glm::vec3(0.09f, 0.25f, 0.15f));
 
-    return std::make_unique<Mesh>(vertices, indices);
+    return std::make_unique<Mesh>(std::move(vertices), std::move(indices), MeshCategory::Primitive);
 }
 
 } // namespace GeometryFactory
@@ -1,11 +1,35 @@
 #include "Mesh.h"
+#include <utility>
 
-Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices)
-    : vertices(vertices), indices(indices) {
+namespace {
+Mesh::MemoryStats s_memoryStats[static_cast<int>(MeshCategory::Count)];
+}
+
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, MeshCategory category, MeshCpuData cpuData)
+    : vertices(std::move(vertices)), indices(std::move(indices)),
+      indexCount(static_cast<unsigned int>(this->indices.size())), category(category),
+      cpuBytes(0), gpuBytes(0) {
     setupMesh();
+
+    gpuBytes = this->vertices.size() * sizeof(Vertex) + this->indices.size() * sizeof(unsigned int);
+    cpuBytes = this->vertices.capacity() * sizeof(Vertex) + this->indices.capacity() * sizeof(unsigned int);
+
+    MemoryStats& stats = s_memoryStats[static_cast<int>(category)];
+    stats.meshCount++;
+    stats.cpuBytes += cpuBytes;
+    stats.gpuBytes += gpuBytes;
+
+    if (cpuData == MeshCpuData::Release) {
+        releaseCpuData();
+    }
 }
 
 Mesh::~Mesh() {
+    MemoryStats& stats = s_memoryStats[static_cast<int>(category)];
+    stats.meshCount--;
+    stats.cpuBytes -= cpuBytes;
+    stats.gpuBytes -= gpuBytes;
+
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
     glDeleteBuffers(1, &EBO);
@@ -13,10 +37,23 @@ Mesh::~Mesh() {
 
 void Mesh::draw() const {
     glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
 }
 
+void Mesh::releaseCpuData() {
+    // swap with empty vectors so the capacity is actually returned
+    std::vector<Vertex>().swap(vertices);
+    std::vector<unsigned int>().swap(indices);
+
+    s_memoryStats[static_cast<int>(category)].cpuBytes -= cpuBytes;
+    cpuBytes = 0;
+}
+
+Mesh::MemoryStats Mesh::getMemoryStats(MeshCategory category) {
+    return s_memoryStats[static_cast<int>(category)];
+}
+
 void Mesh::setupMesh() {
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -25,10 +62,10 @@ void Mesh::setupMesh() {
     glBindVertexArray(VAO);
     
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
     
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
     
     // Position attribute
     glEnableVertexAttribArray(0);
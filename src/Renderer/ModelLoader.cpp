@@ -1,7 +1,8 @@
 #include "ModelLoader.h"
 #include <iostream>
+#include <utility>
 
-std::vector<std::unique_ptr<Mesh>> ModelLoader::loadModel(const std::string& path) {
+std::vector<std::unique_ptr<Mesh>> ModelLoader::loadModel(const std::string& path, MeshCategory category) {
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile(path, 
         aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
@@ -13,23 +14,25 @@ std::vector<std::unique_ptr<Mesh>> ModelLoader::loadModel(const std::string& pat
         return meshes;
     }
 
-    processNode(scene->mRootNode, scene, meshes);
+    processNode(scene->mRootNode, scene, category, meshes);
     return meshes;
 }
 
-void ModelLoader::processNode(aiNode* node, const aiScene* scene, std::vector<std::unique_ptr<Mesh>>& meshes) {
+void ModelLoader::processNode(aiNode* node, const aiScene* scene, MeshCategory category,
+                              std::vector<std::unique_ptr<Mesh>>& meshes) {
     // Process all the node's meshes (if any)
     for(unsigned int i = 0; i < node->mNumMeshes; i++) {
         aiMesh* mesh = scene->mMeshes[node->mMeshes[i]]; 
-        meshes.push_back(processMesh(mesh, scene));
+        meshes.push_back(processMesh(mesh, scene, category));
     }
     // Then do the same for each of its children
     for(unsigned int i = 0; i < node->mNumChildren; i++) {
-        processNode(node->mChildren[i], scene, meshes);
+        processNode(node->mChildren[i], scene, category, meshes);
     }
 }
 
-std::unique_ptr<Mesh> ModelLoader::processMesh(aiMesh* mesh, const aiScene* scene) {
+std::unique_ptr<Mesh> ModelLoader::processMesh(aiMesh* mesh, const aiScene* scene, MeshCategory category,
+                                                MeshCpuData cpuData) {
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
 
@@ -74,5 +77,5 @@ std::unique_ptr<Mesh> ModelLoader::processMesh(aiMesh* mesh, const aiScene* scen
             indices.push_back(face.mIndices[j]);
     }
 
-    return std::make_unique<Mesh>(vertices, indices);
+    return std::make_unique<Mesh>(std::move(vertices), std::move(indices), category, cpuData);
 }
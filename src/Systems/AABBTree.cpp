@@ -0,0 +1,270 @@
+#include "Systems/AABBTree.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+float surfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    glm::vec3 e = boundsMax - boundsMin;
+    return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+}
+}
+
+AABBTree::AABBTree(float margin)
+    : m_root(NULL_NODE), m_freeList(NULL_NODE), m_proxyCount(0), m_margin(margin) {}
+
+void AABBTree::clear() {
+    m_nodes.clear();
+    m_root = NULL_NODE;
+    m_freeList = NULL_NODE;
+    m_proxyCount = 0;
+}
+
+int AABBTree::allocateNode() {
+    int nodeId;
+    if (m_freeList != NULL_NODE) {
+        nodeId = m_freeList;
+        m_freeList = m_nodes[nodeId].parent;
+    } else {
+        nodeId = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    Node& node = m_nodes[nodeId];
+    node.parent = NULL_NODE;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = 0;
+    node.userData = -1;
+    return nodeId;
+}
+
+void AABBTree::freeNode(int nodeId) {
+    m_nodes[nodeId].parent = m_freeList;
+    m_nodes[nodeId].height = -1;
+    m_freeList = nodeId;
+}
+
+int AABBTree::createProxy(const glm::vec3& boundsMin, const glm::vec3& boundsMax, int userData) {
+    int proxyId = allocateNode();
+    Node& node = m_nodes[proxyId];
+    node.boundsMin = boundsMin - glm::vec3(m_margin);
+    node.boundsMax = boundsMax + glm::vec3(m_margin);
+    node.userData = userData;
+
+    insertLeaf(proxyId);
+    ++m_proxyCount;
+    return proxyId;
+}
+
+void AABBTree::destroyProxy(int proxyId) {
+    assert(proxyId >= 0 && proxyId < static_cast<int>(m_nodes.size()) && m_nodes[proxyId].isLeaf());
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    --m_proxyCount;
+}
+
+bool AABBTree::moveProxy(int proxyId, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    Node& node = m_nodes[proxyId];
+    if (node.boundsMin.x <= boundsMin.x && node.boundsMin.y <= boundsMin.y && node.boundsMin.z <= boundsMin.z &&
+        node.boundsMax.x >= boundsMax.x && node.boundsMax.y >= boundsMax.y && node.boundsMax.z >= boundsMax.z) {
+        return false;
+    }
+
+    removeLeaf(proxyId);
+    m_nodes[proxyId].boundsMin = boundsMin - glm::vec3(m_margin);
+    m_nodes[proxyId].boundsMax = boundsMax + glm::vec3(m_margin);
+    insertLeaf(proxyId);
+    return true;
+}
+
+void AABBTree::queryUserData(const glm::vec3& boundsMin, const glm::vec3& boundsMax, std::vector<int>& out) const {
+    out.clear();
+    query(boundsMin, boundsMax, [&out](int userData) {
+        out.push_back(userData);
+        return true;
+    });
+    std::sort(out.begin(), out.end());
+}
+
+void AABBTree::insertLeaf(int leaf) {
+    if (m_root == NULL_NODE) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend toward the sibling that minimizes the total surface area increase
+    const glm::vec3 leafMin = m_nodes[leaf].boundsMin;
+    const glm::vec3 leafMax = m_nodes[leaf].boundsMax;
+    int index = m_root;
+    while (!m_nodes[index].isLeaf()) {
+        const Node& node = m_nodes[index];
+        int child1 = node.child1;
+        int child2 = node.child2;
+
+        float area = surfaceArea(node.boundsMin, node.boundsMax);
+        float combinedArea = surfaceArea(glm::min(node.boundsMin, leafMin), glm::max(node.boundsMax, leafMax));
+
+        // Cost of creating a new parent for this node and the new leaf
+        float cost = 2.0f * combinedArea;
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int child) {
+            const Node& c = m_nodes[child];
+            float enlarged = surfaceArea(glm::min(c.boundsMin, leafMin), glm::max(c.boundsMax, leafMax));
+            if (c.isLeaf()) return enlarged + inheritanceCost;
+            return (enlarged - surfaceArea(c.boundsMin, c.boundsMax)) + inheritanceCost;
+        };
+
+        float cost1 = descendCost(child1);
+        float cost2 = descendCost(child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = (cost1 < cost2) ? child1 : child2;
+    }
+
+    int sibling = index;
+
+    // Create a new parent joining the sibling and the leaf
+    int oldParent = m_nodes[sibling].parent;
+    int newParent = allocateNode();
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].boundsMin = glm::min(leafMin, m_nodes[sibling].boundsMin);
+    m_nodes[newParent].boundsMax = glm::max(leafMax, m_nodes[sibling].boundsMax);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE) {
+        if (m_nodes[oldParent].child1 == sibling) {
+            m_nodes[oldParent].child1 = newParent;
+        } else {
+            m_nodes[oldParent].child2 = newParent;
+        }
+    } else {
+        m_root = newParent;
+    }
+
+    // Walk back up refitting bounds and rebalancing
+    index = m_nodes[leaf].parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        int child1 = m_nodes[index].child1;
+        int child2 = m_nodes[index].child2;
+        m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+        m_nodes[index].boundsMin = glm::min(m_nodes[child1].boundsMin, m_nodes[child2].boundsMin);
+        m_nodes[index].boundsMax = glm::max(m_nodes[child1].boundsMax, m_nodes[child2].boundsMax);
+
+        index = m_nodes[index].parent;
+    }
+}
+
+void AABBTree::removeLeaf(int leaf) {
+    if (leaf == m_root) {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    int parent = m_nodes[leaf].parent;
+    int grandParent = m_nodes[parent].parent;
+    int sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent != NULL_NODE) {
+        // Splice the sibling into the parent's slot
+        if (m_nodes[grandParent].child1 == parent) {
+            m_nodes[grandParent].child1 = sibling;
+        } else {
+            m_nodes[grandParent].child2 = sibling;
+        }
+        m_nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        int index = grandParent;
+        while (index != NULL_NODE) {
+            index = balance(index);
+
+            int child1 = m_nodes[index].child1;
+            int child2 = m_nodes[index].child2;
+            m_nodes[index].boundsMin = glm::min(m_nodes[child1].boundsMin, m_nodes[child2].boundsMin);
+            m_nodes[index].boundsMax = glm::max(m_nodes[child1].boundsMax, m_nodes[child2].boundsMax);
+            m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+
+            index = m_nodes[index].parent;
+        }
+    } else {
+        m_root = sibling;
+        m_nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+// Perform a left or right rotation if node A is imbalanced. Returns the new subtree root.
+int AABBTree::balance(int iA) {
+    const Node& A = m_nodes[iA];
+    if (A.isLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    int iB = A.child1;
+    int iC = A.child2;
+    int heightDiff = m_nodes[iC].height - m_nodes[iB].height;
+
+    auto refit = [this](int index) {
+        Node& n = m_nodes[index];
+        n.boundsMin = glm::min(m_nodes[n.child1].boundsMin, m_nodes[n.child2].boundsMin);
+        n.boundsMax = glm::max(m_nodes[n.child1].boundsMax, m_nodes[n.child2].boundsMax);
+        n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+    };
+
+    // Rotate the taller child up; `up` takes A's place and A becomes its child
+    auto rotateUp = [&](int iUp, bool upIsChild2) {
+        Node& up = m_nodes[iUp];
+        int iF = up.child1;
+        int iG = up.child2;
+
+        up.child1 = iA;
+        up.parent = m_nodes[iA].parent;
+        m_nodes[iA].parent = iUp;
+
+        if (up.parent != NULL_NODE) {
+            if (m_nodes[up.parent].child1 == iA) {
+                m_nodes[up.parent].child1 = iUp;
+            } else {
+                m_nodes[up.parent].child2 = iUp;
+            }
+        } else {
+            m_root = iUp;
+        }
+
+        // Keep the taller grandchild under `up`, hand the shorter one to A
+        int keep = iF, give = iG;
+        if (m_nodes[iF].height < m_nodes[iG].height) {
+            keep = iG;
+            give = iF;
+        }
+        up.child2 = keep;
+        if (upIsChild2) {
+            m_nodes[iA].child2 = give;
+        } else {
+            m_nodes[iA].child1 = give;
+        }
+        m_nodes[give].parent = iA;
+
+        refit(iA);
+        refit(iUp);
+        return iUp;
+    };
+
+    if (heightDiff > 1) {
+        return rotateUp(iC, true);
+    }
+    if (heightDiff < -1) {
+        return rotateUp(iB, false);
+    }
+
+    return iA;
+}
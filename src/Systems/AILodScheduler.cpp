@@ -0,0 +1,67 @@
+#include "AILodScheduler.h"
+#include "Entities/Enemy.h"
+#include "Systems/PerceptionSystem.h"
+#include "Config.h"
+
+AILodScheduler::AILodScheduler()
+    : m_frame(0) {
+    clear();
+}
+
+void AILodScheduler::update(const std::vector<Enemy>& enemies, const glm::vec3& playerPosition,
+                            const PerceptionSystem& perception, float deltaTime) {
+    // Enemies are only ever appended mid-level, so existing entries keep the time they have skipped
+    m_pendingTime.resize(enemies.size(), 0.0f);
+    m_tiers.assign(enemies.size(), Tier::Full);
+    m_active.assign(enemies.size(), 0);
+    for (int tier = 0; tier < static_cast<int>(Tier::Count); ++tier) {
+        m_enemyCounts[tier] = 0;
+        m_updatedCounts[tier] = 0;
+    }
+
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        const Enemy& enemy = enemies[i];
+        if (!enemy.isAlive()) {
+            m_pendingTime[i] = 0.0f;
+            continue;
+        }
+        m_pendingTime[i] += deltaTime;
+
+        float distance = glm::length(playerPosition - enemy.getPosition());
+        Tier tier = Tier::Full;
+        int interval = 1;
+        if (!enemy.isTrackingPlayer() && !perception.hasLineOfSight(i)) {
+            if (distance > Config::AI_LOD_FAR_DISTANCE) {
+                tier = Tier::Far;
+                interval = Config::AI_LOD_FAR_INTERVAL;
+            } else if (distance > Config::AI_LOD_NEAR_DISTANCE) {
+                tier = Tier::Medium;
+                interval = Config::AI_LOD_MEDIUM_INTERVAL;
+            }
+        }
+
+        m_tiers[i] = tier;
+        m_enemyCounts[static_cast<int>(tier)]++;
+        if (interval <= 1 || (m_frame + i) % static_cast<uint32_t>(interval) == 0) {
+            m_active[i] = 1;
+            m_updatedCounts[static_cast<int>(tier)]++;
+        }
+    }
+    m_frame++;
+}
+
+void AILodScheduler::clear() {
+    m_tiers.clear();
+    m_active.clear();
+    m_pendingTime.clear();
+    for (int tier = 0; tier < static_cast<int>(Tier::Count); ++tier) {
+        m_enemyCounts[tier] = 0;
+        m_updatedCounts[tier] = 0;
+    }
+}
+
+float AILodScheduler::consumeDeltaTime(size_t enemyIndex) {
+    float time = m_pendingTime[enemyIndex];
+    m_pendingTime[enemyIndex] = 0.0f;
+    return time;
+}
@@ -0,0 +1,43 @@
+#include "Systems/CollisionMesh.h"
+#include "Renderer/Mesh.h"
+#include <cmath>
+#include <utility>
+
+namespace {
+bool isFinite(const glm::vec3& v) {
+    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+}
+}
+
+CollisionMesh::CollisionMesh(TriangleBVH&& bvh)
+    : m_bvh(std::move(bvh)) {
+}
+
+void CollisionMesh::addTriangles(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                                 const glm::mat4& transform) {
+    m_staging.reserve(m_staging.size() + indices.size() / 3);
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        if (indices[i] >= vertices.size() || indices[i+1] >= vertices.size() || indices[i+2] >= vertices.size()) {
+            m_droppedCount++;
+            continue;
+        }
+
+        TriangleBVH::Triangle tri;
+        tri.v0 = glm::vec3(transform * glm::vec4(vertices[indices[i]].Position, 1.0f));
+        tri.v1 = glm::vec3(transform * glm::vec4(vertices[indices[i+1]].Position, 1.0f));
+        tri.v2 = glm::vec3(transform * glm::vec4(vertices[indices[i+2]].Position, 1.0f));
+
+        float doubleArea = glm::length(glm::cross(tri.v1 - tri.v0, tri.v2 - tri.v0));
+        if (!isFinite(tri.v0) || !isFinite(tri.v1) || !isFinite(tri.v2) || !(doubleArea > DEGENERATE_AREA_EPSILON)) {
+            m_droppedCount++;
+            continue;
+        }
+        m_staging.push_back(tri);
+    }
+}
+
+void CollisionMesh::cook() {
+    m_bvh.build(std::move(m_staging));
+    m_staging = std::vector<TriangleBVH::Triangle>();
+}
@@ -0,0 +1,42 @@
+#include "Systems/FlowField.h"
+#include "Systems/NavigationGraph.h"
+#include <limits>
+
+FlowField::FlowField() : targetNode(-1), rebuildCount(0) {}
+
+bool FlowField::update(const NavigationGraph& graph, const glm::vec3& target) {
+    if (!graph.isValid()) {
+        invalidate();
+        return false;
+    }
+
+    int node = graph.getClosestNode(target);
+    if (node == targetNode && nextHop.size() == graph.getNodes().size()) {
+        return false;
+    }
+
+    targetNode = node;
+    graph.computeFlowField(targetNode, nextHop, costToTarget);
+    rebuildCount++;
+    return true;
+}
+
+void FlowField::invalidate() {
+    targetNode = -1;
+    nextHop.clear();
+    costToTarget.clear();
+}
+
+int FlowField::getNextNode(int node) const {
+    if (node < 0 || node >= static_cast<int>(nextHop.size())) {
+        return -1;
+    }
+    return nextHop[node];
+}
+
+float FlowField::getCostToTarget(int node) const {
+    if (node < 0 || node >= static_cast<int>(costToTarget.size())) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return costToTarget[node];
+}
@@ -0,0 +1,412 @@
+#include "Systems/HierarchicalPathfinder.h"
+#include "Systems/NavigationGraph.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace {
+// Generation-stamped scratch shared by the cluster Dijkstra and the abstract A*
+struct Scratch {
+    std::vector<float> cost;
+    std::vector<int> cameFrom;
+    std::vector<uint32_t> generation;
+    std::vector<std::pair<float, int>> heap;
+    uint32_t currentGeneration = 0;
+
+    void begin(size_t count) {
+        if (generation.size() < count) {
+            cost.resize(count);
+            cameFrom.resize(count);
+            generation.resize(count, 0);
+        }
+        if (++currentGeneration == 0) {
+            std::fill(generation.begin(), generation.end(), 0u);
+            currentGeneration = 1;
+        }
+        heap.clear();
+    }
+
+    bool visited(int i) const { return generation[i] == currentGeneration; }
+};
+
+Scratch& getScratch() {
+    static thread_local Scratch scratch;
+    return scratch;
+}
+}
+
+void HierarchicalPathfinder::clear() {
+    m_graph = nullptr;
+    m_clusterCount = 0;
+    m_clusterOf.clear();
+    m_abstractIndex.clear();
+    m_entranceNodes.clear();
+    m_clusterEntranceOffsets.clear();
+    m_clusterEntrances.clear();
+    m_abstractOffsets.clear();
+    m_abstractTargets.clear();
+    m_abstractCosts.clear();
+}
+
+void HierarchicalPathfinder::build(const NavigationGraph& graph, float clusterSize) {
+    clear();
+
+    const auto& nodes = graph.getNodes();
+    const int n = static_cast<int>(nodes.size());
+    if (n == 0) {
+        return;
+    }
+    m_graph = &graph;
+
+    // 1. Clusters: connected components of the graph restricted to each coarse grid cell
+    std::vector<glm::ivec3> cells(n);
+    for (int i = 0; i < n; ++i) {
+        cells[i] = glm::ivec3(static_cast<int>(std::floor(nodes[i].position.x / clusterSize)),
+                              static_cast<int>(std::floor(nodes[i].position.y / clusterSize)),
+                              static_cast<int>(std::floor(nodes[i].position.z / clusterSize)));
+    }
+
+    m_clusterOf.assign(n, -1);
+    std::vector<int> stack;
+    for (int seed = 0; seed < n; ++seed) {
+        if (m_clusterOf[seed] != -1) continue;
+
+        int cluster = m_clusterCount++;
+        m_clusterOf[seed] = cluster;
+        stack.push_back(seed);
+        while (!stack.empty()) {
+            int node = stack.back();
+            stack.pop_back();
+            for (int e = graph.getEdgeBegin(node); e < graph.getEdgeEnd(node); ++e) {
+                int neighbor = graph.getEdgeTarget(e);
+                if (m_clusterOf[neighbor] == -1 && cells[neighbor] == cells[seed]) {
+                    m_clusterOf[neighbor] = cluster;
+                    stack.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    // 2. Transitions: of all the edges along the border between two clusters keep only a few,
+    // spread evenly along the border. Fewer entrances keep the abstract graph small; paths
+    // that would have crossed elsewhere detour slightly inside the clusters.
+    std::vector<glm::vec3> centroids(m_clusterCount, glm::vec3(0.0f));
+    std::vector<int> clusterSizes(m_clusterCount, 0);
+    for (int i = 0; i < n; ++i) {
+        centroids[m_clusterOf[i]] += nodes[i].position;
+        clusterSizes[m_clusterOf[i]]++;
+    }
+    for (int c = 0; c < m_clusterCount; ++c) {
+        centroids[c] /= static_cast<float>(clusterSizes[c]);
+    }
+
+    struct BorderEdge {
+        int clusterA, clusterB; // clusterA < clusterB
+        int from, to;           // from is in clusterA
+        float cost;
+        float offset;           // Position along the border, filled per border
+    };
+    std::vector<BorderEdge> borderEdges;
+    for (int node = 0; node < n; ++node) {
+        for (int e = graph.getEdgeBegin(node); e < graph.getEdgeEnd(node); ++e) {
+            int neighbor = graph.getEdgeTarget(e);
+            if (m_clusterOf[node] < m_clusterOf[neighbor]) {
+                borderEdges.push_back({m_clusterOf[node], m_clusterOf[neighbor], node, neighbor, graph.getEdgeCost(e), 0.0f});
+            }
+        }
+    }
+    std::sort(borderEdges.begin(), borderEdges.end(), [](const BorderEdge& a, const BorderEdge& b) {
+        return a.clusterA != b.clusterA ? a.clusterA < b.clusterA : a.clusterB < b.clusterB;
+    });
+
+    std::vector<BorderEdge> transitions;
+    for (size_t begin = 0; begin < borderEdges.size();) {
+        size_t end = begin;
+        while (end < borderEdges.size() && borderEdges[end].clusterA == borderEdges[begin].clusterA &&
+               borderEdges[end].clusterB == borderEdges[begin].clusterB) {
+            ++end;
+        }
+
+        // Order the border's edges along the horizontal direction perpendicular to the cluster link
+        glm::vec3 link = centroids[borderEdges[begin].clusterB] - centroids[borderEdges[begin].clusterA];
+        glm::vec3 along(-link.z, 0.0f, link.x);
+        for (size_t i = begin; i < end; ++i) {
+            glm::vec3 midpoint = 0.5f * (nodes[borderEdges[i].from].position + nodes[borderEdges[i].to].position);
+            borderEdges[i].offset = glm::dot(midpoint, along);
+        }
+        std::sort(borderEdges.begin() + begin, borderEdges.begin() + end,
+                  [](const BorderEdge& a, const BorderEdge& b) { return a.offset < b.offset; });
+
+        size_t count = end - begin;
+        size_t keep = std::min(count, 1 + count / EDGES_PER_TRANSITION);
+        for (size_t k = 0; k < keep; ++k) {
+            transitions.push_back(borderEdges[begin + (2 * k + 1) * count / (2 * keep)]);
+        }
+        begin = end;
+    }
+
+    m_abstractIndex.assign(n, -1);
+    for (const BorderEdge& transition : transitions) {
+        for (int node : {transition.from, transition.to}) {
+            if (m_abstractIndex[node] == -1) {
+                m_abstractIndex[node] = static_cast<int>(m_entranceNodes.size());
+                m_entranceNodes.push_back(node);
+            }
+        }
+    }
+
+    m_clusterEntranceOffsets.assign(m_clusterCount + 1, 0);
+    for (int node : m_entranceNodes) {
+        m_clusterEntranceOffsets[m_clusterOf[node] + 1]++;
+    }
+    for (int c = 0; c < m_clusterCount; ++c) {
+        m_clusterEntranceOffsets[c + 1] += m_clusterEntranceOffsets[c];
+    }
+    m_clusterEntrances.resize(m_entranceNodes.size());
+    std::vector<int> cursor(m_clusterEntranceOffsets.begin(), m_clusterEntranceOffsets.end() - 1);
+    for (size_t i = 0; i < m_entranceNodes.size(); ++i) {
+        m_clusterEntrances[cursor[m_clusterOf[m_entranceNodes[i]]]++] = static_cast<int>(i);
+    }
+
+    // 3. Abstract edges: the transitions themselves, plus cluster-local shortest paths between entrances
+    std::vector<std::vector<std::pair<int, float>>> adjacency(m_entranceNodes.size());
+    for (const BorderEdge& transition : transitions) {
+        int a = m_abstractIndex[transition.from];
+        int b = m_abstractIndex[transition.to];
+        adjacency[a].push_back({b, transition.cost});
+        adjacency[b].push_back({a, transition.cost});
+    }
+    std::vector<std::pair<int, float>> reached;
+    for (size_t i = 0; i < m_entranceNodes.size(); ++i) {
+        costsToEntrances(m_entranceNodes[i], reached);
+        for (const auto& [entrance, cost] : reached) {
+            if (entrance != static_cast<int>(i)) {
+                adjacency[i].push_back({entrance, cost});
+            }
+        }
+    }
+
+    m_abstractOffsets.assign(m_entranceNodes.size() + 1, 0);
+    for (size_t i = 0; i < adjacency.size(); ++i) {
+        m_abstractOffsets[i + 1] = m_abstractOffsets[i] + static_cast<int>(adjacency[i].size());
+    }
+    m_abstractTargets.reserve(m_abstractOffsets.back());
+    m_abstractCosts.reserve(m_abstractOffsets.back());
+    for (const auto& links : adjacency) {
+        for (const auto& [target, cost] : links) {
+            m_abstractTargets.push_back(target);
+            m_abstractCosts.push_back(cost);
+        }
+    }
+}
+
+void HierarchicalPathfinder::costsToEntrances(int sourceNode, std::vector<std::pair<int, float>>& out) const {
+    out.clear();
+    const NavigationGraph& graph = *m_graph;
+    const int cluster = m_clusterOf[sourceNode];
+    const auto compare = std::greater<std::pair<float, int>>();
+
+    Scratch& scratch = getScratch();
+    scratch.begin(graph.getNodes().size());
+    scratch.generation[sourceNode] = scratch.currentGeneration;
+    scratch.cost[sourceNode] = 0.0f;
+    scratch.heap.push_back({0.0f, sourceNode});
+
+    // Stop early once every entrance of the cluster has been settled
+    int entrancesLeft = m_clusterEntranceOffsets[cluster + 1] - m_clusterEntranceOffsets[cluster];
+
+    while (!scratch.heap.empty() && entrancesLeft > 0) {
+        std::pop_heap(scratch.heap.begin(), scratch.heap.end(), compare);
+        auto [cost, node] = scratch.heap.back();
+        scratch.heap.pop_back();
+        if (cost > scratch.cost[node]) continue;
+
+        if (m_abstractIndex[node] != -1) {
+            out.push_back({m_abstractIndex[node], cost});
+            entrancesLeft--;
+        }
+
+        for (int e = graph.getEdgeBegin(node); e < graph.getEdgeEnd(node); ++e) {
+            int neighbor = graph.getEdgeTarget(e);
+            if (m_clusterOf[neighbor] != cluster) continue;
+            float tentative = cost + graph.getEdgeCost(e);
+            if (!scratch.visited(neighbor) || tentative < scratch.cost[neighbor]) {
+                scratch.generation[neighbor] = scratch.currentGeneration;
+                scratch.cost[neighbor] = tentative;
+                scratch.heap.push_back({tentative, neighbor});
+                std::push_heap(scratch.heap.begin(), scratch.heap.end(), compare);
+            }
+        }
+    }
+}
+
+bool HierarchicalPathfinder::findPath(const glm::vec3& start, const glm::vec3& goal, Path& outPath) const {
+    outPath.clear();
+    outPath.goal = goal;
+    if (!m_graph) {
+        return false;
+    }
+
+    const auto& nodes = m_graph->getNodes();
+    int startNode = m_graph->getClosestNode(start);
+    int goalNode = m_graph->getClosestNode(goal);
+    if (startNode == -1 || goalNode == -1) {
+        return false;
+    }
+
+    // Clusters are connected, so a same-cluster query is always answered by one local segment
+    if (startNode == goalNode || m_clusterOf[startNode] == m_clusterOf[goalNode]) {
+        outPath.waypoints.push_back(startNode);
+        if (goalNode != startNode) outPath.waypoints.push_back(goalNode);
+        outPath.finished = false;
+        return true;
+    }
+
+    std::vector<std::pair<int, float>> startCosts;
+    std::vector<std::pair<int, float>> goalCosts;
+    costsToEntrances(startNode, startCosts);
+    costsToEntrances(goalNode, goalCosts);
+    if (startCosts.empty() || goalCosts.empty()) {
+        return false;
+    }
+
+    // A* over entrances; index `goalSlot` is a virtual node standing for the goal itself
+    const int entranceCount = static_cast<int>(m_entranceNodes.size());
+    const int goalSlot = entranceCount;
+    const int goalCluster = m_clusterOf[goalNode];
+    const glm::vec3 goalPosition = nodes[goalNode].position;
+    const auto compare = std::greater<std::pair<float, int>>();
+
+    Scratch& scratch = getScratch();
+    scratch.begin(entranceCount + 1);
+
+    for (const auto& [entrance, cost] : startCosts) {
+        scratch.generation[entrance] = scratch.currentGeneration;
+        scratch.cost[entrance] = cost;
+        scratch.cameFrom[entrance] = -1;
+        scratch.heap.push_back({cost + glm::distance(nodes[m_entranceNodes[entrance]].position, goalPosition), entrance});
+    }
+    std::make_heap(scratch.heap.begin(), scratch.heap.end(), compare);
+
+    bool found = false;
+    while (!scratch.heap.empty()) {
+        std::pop_heap(scratch.heap.begin(), scratch.heap.end(), compare);
+        auto [fScore, current] = scratch.heap.back();
+        scratch.heap.pop_back();
+
+        if (current == goalSlot) {
+            found = true;
+            break;
+        }
+
+        float currentCost = scratch.cost[current];
+        const glm::vec3& currentPosition = nodes[m_entranceNodes[current]].position;
+        if (fScore > currentCost + glm::distance(currentPosition, goalPosition)) {
+            continue; // Stale entry
+        }
+
+        auto relax = [&](int target, float cost, float heuristic) {
+            if (!scratch.visited(target) || cost < scratch.cost[target]) {
+                scratch.generation[target] = scratch.currentGeneration;
+                scratch.cost[target] = cost;
+                scratch.cameFrom[target] = current;
+                scratch.heap.push_back({cost + heuristic, target});
+                std::push_heap(scratch.heap.begin(), scratch.heap.end(), compare);
+            }
+        };
+
+        if (m_clusterOf[m_entranceNodes[current]] == goalCluster) {
+            for (const auto& [entrance, cost] : goalCosts) {
+                if (entrance == current) {
+                    relax(goalSlot, currentCost + cost, 0.0f);
+                    break;
+                }
+            }
+        }
+
+        for (int e = m_abstractOffsets[current]; e < m_abstractOffsets[current + 1]; ++e) {
+            int target = m_abstractTargets[e];
+            relax(target, currentCost + m_abstractCosts[e],
+                  glm::distance(nodes[m_entranceNodes[target]].position, goalPosition));
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    std::vector<int> entrances;
+    for (int slot = scratch.cameFrom[goalSlot]; slot != -1; slot = scratch.cameFrom[slot]) {
+        entrances.push_back(m_entranceNodes[slot]);
+    }
+    std::reverse(entrances.begin(), entrances.end());
+
+    outPath.waypoints.push_back(startNode);
+    for (int node : entrances) {
+        if (node != outPath.waypoints.back()) outPath.waypoints.push_back(node);
+    }
+    if (goalNode != outPath.waypoints.back()) outPath.waypoints.push_back(goalNode);
+    outPath.finished = false;
+    return true;
+}
+
+bool HierarchicalPathfinder::refine(Path& path, int segments, std::vector<glm::vec3>& waypoints) const {
+    if (path.finished || !m_graph || segments <= 0) {
+        return false;
+    }
+
+    const auto& nodes = m_graph->getNodes();
+    const auto& w = path.waypoints;
+
+    // Same node: NavigationGraph::findPath answers with just the goal
+    if (w.size() == 1) {
+        waypoints.push_back(path.goal);
+        path.finished = true;
+        return true;
+    }
+
+    if (path.nextSegment == 0) {
+        waypoints.push_back(nodes[w[0]].position);
+    }
+
+    std::vector<int> local;
+    while (segments > 0 && path.nextSegment + 1 < w.size()) {
+        int from = w[path.nextSegment];
+        int to = w[path.nextSegment + 1];
+        int cluster = m_clusterOf[from];
+
+        if (m_clusterOf[to] == cluster) {
+            if (!m_graph->findNodePathWithin(from, to, [&](int node) { return m_clusterOf[node] == cluster; }, local)) {
+                // Cannot happen for a graph that has not changed since build(); give up on the rest
+                path.finished = true;
+                return true;
+            }
+            for (size_t i = 1; i < local.size(); ++i) {
+                waypoints.push_back(nodes[local[i]].position);
+            }
+        } else {
+            // Consecutive entrances in different clusters are joined by a real edge
+            waypoints.push_back(nodes[to].position);
+        }
+
+        path.nextSegment++;
+        segments--;
+    }
+
+    if (path.nextSegment + 1 >= w.size()) {
+        waypoints.push_back(path.goal);
+        path.finished = true;
+    }
+    return true;
+}
+
+std::vector<glm::vec3> HierarchicalPathfinder::findFullPath(const glm::vec3& start, const glm::vec3& goal) const {
+    Path path;
+    std::vector<glm::vec3> waypoints;
+    if (findPath(start, goal, path)) {
+        refine(path, INT_MAX, waypoints);
+    }
+    return waypoints;
+}
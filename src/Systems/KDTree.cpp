@@ -0,0 +1,195 @@
+#include "Systems/KDTree.h"
+#include <glm/gtx/norm.hpp>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+void KDTree::build(const std::vector<glm::vec3>& points) {
+    m_indices.resize(points.size());
+    std::iota(m_indices.begin(), m_indices.end(), 0);
+    m_splitAxis.assign(points.size(), 0);
+
+    buildRange(points, 0, static_cast<int>(points.size()));
+
+    // Store points in tree order so queries walk memory linearly
+    m_points.resize(points.size());
+    for (size_t i = 0; i < m_indices.size(); ++i) {
+        m_points[i] = points[m_indices[i]];
+    }
+}
+
+void KDTree::clear() {
+    m_points.clear();
+    m_indices.clear();
+    m_splitAxis.clear();
+}
+
+void KDTree::buildRange(const std::vector<glm::vec3>& points, int begin, int end) {
+    // Recursion depth is log2(n), so this stays shallow even for huge graphs
+    if (end - begin <= 1) {
+        return;
+    }
+
+    // Split along the widest axis of this range
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for (int i = begin; i < end; ++i) {
+        boundsMin = glm::min(boundsMin, points[m_indices[i]]);
+        boundsMax = glm::max(boundsMax, points[m_indices[i]]);
+    }
+    glm::vec3 extent = boundsMax - boundsMin;
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    int mid = begin + (end - begin) / 2;
+    std::nth_element(m_indices.begin() + begin, m_indices.begin() + mid, m_indices.begin() + end, [&](int a, int b) {
+        return points[a][axis] < points[b][axis];
+    });
+
+    m_splitAxis[mid] = static_cast<uint8_t>(axis);
+    buildRange(points, begin, mid);
+    buildRange(points, mid + 1, end);
+}
+
+int KDTree::nearest(const glm::vec3& position) const {
+    if (m_indices.empty()) {
+        return -1;
+    }
+
+    int bestSlot = -1;
+    float bestDistSq = std::numeric_limits<float>::max();
+    nearestRange(0, static_cast<int>(m_indices.size()), position, bestSlot, bestDistSq);
+    return m_indices[bestSlot];
+}
+
+void KDTree::nearestRange(int begin, int end, const glm::vec3& position, int& bestSlot, float& bestDistSq) const {
+    if (begin >= end) {
+        return;
+    }
+
+    int mid = begin + (end - begin) / 2;
+    float distSq = glm::distance2(position, m_points[mid]);
+    if (bestSlot < 0 || distSq < bestDistSq || (distSq == bestDistSq && m_indices[mid] < m_indices[bestSlot])) {
+        bestDistSq = distSq;
+        bestSlot = mid;
+    }
+
+    if (end - begin == 1) {
+        return;
+    }
+
+    int axis = m_splitAxis[mid];
+    float diff = position[axis] - m_points[mid][axis];
+    bool goLeft = diff < 0.0f;
+
+    // Near side first, then the far side only if the splitting plane is within reach
+    if (goLeft) {
+        nearestRange(begin, mid, position, bestSlot, bestDistSq);
+    } else {
+        nearestRange(mid + 1, end, position, bestSlot, bestDistSq);
+    }
+    if (diff * diff <= bestDistSq) {
+        if (goLeft) {
+            nearestRange(mid + 1, end, position, bestSlot, bestDistSq);
+        } else {
+            nearestRange(begin, mid, position, bestSlot, bestDistSq);
+        }
+    }
+}
+
+void KDTree::kNearest(const glm::vec3& position, size_t k, std::vector<int>& out) const {
+    out.clear();
+    if (m_indices.empty() || k == 0) {
+        return;
+    }
+
+    std::vector<std::pair<float, int>> heap;
+    heap.reserve(k + 1);
+    kNearestRange(0, static_cast<int>(m_indices.size()), position, k, heap);
+
+    std::sort_heap(heap.begin(), heap.end());
+    out.reserve(heap.size());
+    for (const auto& entry : heap) {
+        out.push_back(m_indices[entry.second]);
+    }
+}
+
+void KDTree::kNearestRange(int begin, int end, const glm::vec3& position, size_t k, std::vector<std::pair<float, int>>& heap) const {
+    if (begin >= end) {
+        return;
+    }
+
+    int mid = begin + (end - begin) / 2;
+    float distSq = glm::distance2(position, m_points[mid]);
+    if (heap.size() < k) {
+        heap.push_back({distSq, mid});
+        std::push_heap(heap.begin(), heap.end());
+    } else if (distSq < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = {distSq, mid};
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    if (end - begin == 1) {
+        return;
+    }
+
+    int axis = m_splitAxis[mid];
+    float diff = position[axis] - m_points[mid][axis];
+    bool goLeft = diff < 0.0f;
+
+    if (goLeft) {
+        kNearestRange(begin, mid, position, k, heap);
+    } else {
+        kNearestRange(mid + 1, end, position, k, heap);
+    }
+    if (heap.size() < k || diff * diff <= heap.front().first) {
+        if (goLeft) {
+            kNearestRange(mid + 1, end, position, k, heap);
+        } else {
+            kNearestRange(begin, mid, position, k, heap);
+        }
+    }
+}
+
+void KDTree::withinRadius(const glm::vec3& position, float radius, std::vector<int>& out) const {
+    out.clear();
+    if (m_indices.empty() || radius < 0.0f) {
+        return;
+    }
+
+    std::vector<std::pair<float, int>> found;
+    radiusRange(0, static_cast<int>(m_indices.size()), position, radius * radius, found);
+
+    std::sort(found.begin(), found.end());
+    out.reserve(found.size());
+    for (const auto& entry : found) {
+        out.push_back(m_indices[entry.second]);
+    }
+}
+
+void KDTree::radiusRange(int begin, int end, const glm::vec3& position, float radiusSq, std::vector<std::pair<float, int>>& found) const {
+    if (begin >= end) {
+        return;
+    }
+
+    int mid = begin + (end - begin) / 2;
+    float distSq = glm::distance2(position, m_points[mid]);
+    if (distSq <= radiusSq) {
+        found.push_back({distSq, mid});
+    }
+
+    if (end - begin == 1) {
+        return;
+    }
+
+    int axis = m_splitAxis[mid];
+    float diff = position[axis] - m_points[mid][axis];
+    if (diff < 0.0f || diff * diff <= radiusSq) {
+        radiusRange(begin, mid, position, radiusSq, found);
+    }
+    if (diff >= 0.0f || diff * diff <= radiusSq) {
+        radiusRange(mid + 1, end, position, radiusSq, found);
+    }
+}
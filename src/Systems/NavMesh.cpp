@@ -0,0 +1,559 @@
+#include "Systems/NavMesh.h"
+#include "Config.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+// Solid interval of one heightfield column, in cell-height units above the bounds minimum
+struct Span {
+    int bottom;
+    int top;
+    bool walkable;
+};
+using Column = std::vector<Span>; // Sorted bottom-up, never overlapping
+
+// Open space on top of a walkable span
+struct Cell {
+    int x, z;
+    int top;
+    int ceiling;      // Bottom of the next span up, INT_MAX if open sky
+    int neighbors[4]; // Linked cell per direction (+x, +z, -x, -z), -1 if not walkable to
+};
+
+constexpr int DIR_X[4] = {1, 0, -1, 0};
+constexpr int DIR_Z[4] = {0, 1, 0, -1};
+
+// Insert a span, merging it with every span it overlaps. When merged tops are within
+// mergeThreshold of each other either can make the result walkable; otherwise the higher top wins.
+void addSpan(Column& column, int bottom, int top, bool walkable, int mergeThreshold) {
+    Span merged{bottom, top, walkable};
+    size_t write = 0;
+    size_t insertAt = 0;
+    for (size_t read = 0; read < column.size(); ++read) {
+        Span span = column[read];
+        if (span.top < merged.bottom) {
+            column[write++] = span;
+            insertAt = write;
+        } else if (span.bottom > merged.top) {
+            column[write++] = span;
+        } else {
+            if (std::abs(span.top - merged.top) <= mergeThreshold) {
+                merged.walkable = merged.walkable || span.walkable;
+            } else if (span.top > merged.top) {
+                merged.walkable = span.walkable;
+            }
+            merged.bottom = std::min(merged.bottom, span.bottom);
+            merged.top = std::max(merged.top, span.top);
+        }
+    }
+    column.resize(write);
+    column.insert(column.begin() + insertAt, merged);
+}
+
+// Sutherland-Hodgman against one axis-aligned plane; keeps the side below (or above) value
+void clipPolygon(const std::vector<glm::vec3>& in, int axis, float value, bool keepBelow, std::vector<glm::vec3>& out) {
+    out.clear();
+    for (size_t i = 0; i < in.size(); ++i) {
+        const glm::vec3& a = in[i];
+        const glm::vec3& b = in[(i + 1) % in.size()];
+        float da = keepBelow ? value - a[axis] : a[axis] - value;
+        float db = keepBelow ? value - b[axis] : b[axis] - value;
+        if (da >= 0.0f) {
+            out.push_back(a);
+        }
+        if ((da >= 0.0f) != (db >= 0.0f)) {
+            out.push_back(a + (b - a) * (da / (da - db)));
+        }
+    }
+}
+
+float cross2D(const glm::vec3& a, const glm::vec3& b) {
+    return a.x * b.z - a.z * b.x;
+}
+
+// Run body(begin, end) over [0, count) split across up to threadCount threads
+template <typename Body>
+void parallelFor(size_t count, unsigned threadCount, Body body) {
+    size_t chunks = std::min<size_t>(threadCount, count);
+    if (chunks <= 1) {
+        body(size_t(0), count);
+        return;
+    }
+    std::vector<std::thread> workers;
+    size_t chunkSize = (count + chunks - 1) / chunks;
+    for (size_t begin = 0; begin < count; begin += chunkSize) {
+        workers.emplace_back(body, begin, std::min(count, begin + chunkSize));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+}
+
+NavMesh::Settings NavMesh::defaultSettings() {
+    Settings settings;
+    settings.cellSize = Config::NAV_CELL_SIZE;
+    settings.cellHeight = Config::NAV_CELL_HEIGHT;
+    settings.agentHeight = Config::PLAYER_HEIGHT;
+    settings.agentRadius = Config::PLAYER_WIDTH * 0.5f;
+    settings.maxStepHeight = Config::NAV_MAX_STEP_HEIGHT;
+    settings.maxSlopeDegrees = Config::NAV_MAX_SLOPE_DEGREES;
+    settings.maxPolygonCells = 32;
+    settings.threadCount = 0;
+    return settings;
+}
+
+void NavMesh::clear() {
+    m_polygons.clear();
+    m_portalOffsets.clear();
+    m_portals.clear();
+    m_bucketOffsets.clear();
+    m_bucketPolygons.clear();
+    m_bucketsX = 0;
+    m_bucketsZ = 0;
+    m_walkableCellCount = 0;
+}
+
+void NavMesh::build(const std::vector<glm::vec3>& triangles, const Settings& settings) {
+    auto buildStart = std::chrono::steady_clock::now();
+    clear();
+    m_lastBuildTimeMs = 0.0f;
+    m_maxStepHeight = settings.maxStepHeight;
+
+    if (triangles.size() < 3) {
+        return;
+    }
+
+    unsigned threadCount = settings.threadCount > 0 ? static_cast<unsigned>(settings.threadCount)
+                                                    : std::max(1u, std::thread::hardware_concurrency());
+
+    // 1. Heightfield bounds
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for (const glm::vec3& v : triangles) {
+        boundsMin = glm::min(boundsMin, v);
+        boundsMax = glm::max(boundsMax, v);
+    }
+
+    float cellSize = settings.cellSize;
+    const float cellHeight = settings.cellHeight;
+    int width = std::max(1, static_cast<int>(std::ceil((boundsMax.x - boundsMin.x) / cellSize)));
+    int depth = std::max(1, static_cast<int>(std::ceil((boundsMax.z - boundsMin.z) / cellSize)));
+    if (static_cast<size_t>(width) * depth > MAX_GRID_COLUMNS) {
+        cellSize *= std::sqrt(static_cast<float>(static_cast<size_t>(width) * depth) / MAX_GRID_COLUMNS);
+        width = std::max(1, static_cast<int>(std::ceil((boundsMax.x - boundsMin.x) / cellSize)));
+        depth = std::max(1, static_cast<int>(std::ceil((boundsMax.z - boundsMin.z) / cellSize)));
+        std::cout << "[NavMesh] Level too large for the configured cell size, using " << cellSize << std::endl;
+    }
+
+    const int climbCells = static_cast<int>(std::floor(settings.maxStepHeight / cellHeight));
+    const int headroomCells = static_cast<int>(std::ceil(settings.agentHeight / cellHeight));
+    const int radiusCells = static_cast<int>(std::ceil(settings.agentRadius / cellSize));
+    const float minNormalY = std::cos(glm::radians(settings.maxSlopeDegrees));
+
+    // 2. Voxelize. Each thread owns a band of rows, so columns are never shared.
+    std::vector<Column> columns(static_cast<size_t>(width) * depth);
+    const size_t triangleCount = triangles.size() / 3;
+    parallelFor(static_cast<size_t>(depth), threadCount, [&](size_t rowBegin, size_t rowEnd) {
+        std::vector<glm::vec3> polygon, clipped, row, cell;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const glm::vec3& v0 = triangles[t * 3];
+            const glm::vec3& v1 = triangles[t * 3 + 1];
+            const glm::vec3& v2 = triangles[t * 3 + 2];
+
+            glm::vec3 triMin = glm::min(v0, glm::min(v1, v2));
+            glm::vec3 triMax = glm::max(v0, glm::max(v1, v2));
+            int z0 = std::max(static_cast<int>(rowBegin), static_cast<int>(std::floor((triMin.z - boundsMin.z) / cellSize)));
+            int z1 = std::min(static_cast<int>(rowEnd) - 1, static_cast<int>(std::floor((triMax.z - boundsMin.z) / cellSize)));
+            if (z0 > z1) continue;
+
+            glm::vec3 normal = glm::cross(v1 - v0, v2 - v0);
+            float area = glm::length(normal);
+            if (area <= 0.0f) continue;
+            bool walkable = normal.y / area >= minNormalY;
+
+            polygon = {v0, v1, v2};
+            for (int z = z0; z <= z1; ++z) {
+                float rowMinZ = boundsMin.z + z * cellSize;
+                clipPolygon(polygon, 2, rowMinZ, false, clipped);
+                clipPolygon(clipped, 2, rowMinZ + cellSize, true, row);
+                if (row.size() < 3) continue;
+
+                float rowMinX = row[0].x, rowMaxX = row[0].x;
+                for (const glm::vec3& p : row) {
+                    rowMinX = std::min(rowMinX, p.x);
+                    rowMaxX = std::max(rowMaxX, p.x);
+                }
+                int x0 = std::max(0, static_cast<int>(std::floor((rowMinX - boundsMin.x) / cellSize)));
+                int x1 = std::min(width - 1, static_cast<int>(std::floor((rowMaxX - boundsMin.x) / cellSize)));
+
+                for (int x = x0; x <= x1; ++x) {
+                    float cellMinX = boundsMin.x + x * cellSize;
+                    clipPolygon(row, 0, cellMinX, false, clipped);
+                    clipPolygon(clipped, 0, cellMinX + cellSize, true, cell);
+                    if (cell.size() < 3) continue;
+
+                    float minY = cell[0].y, maxY = cell[0].y;
+                    for (const glm::vec3& p : cell) {
+                        minY = std::min(minY, p.y);
+                        maxY = std::max(maxY, p.y);
+                    }
+                    int bottom = std::max(0, static_cast<int>(std::floor((minY - boundsMin.y) / cellHeight)));
+                    // Small bias so surfaces lying exactly on a voxel boundary do not round up a whole cell
+                    int top = std::max(bottom, static_cast<int>(std::ceil((maxY - boundsMin.y) / cellHeight - 0.001f)));
+                    addSpan(columns[x + static_cast<size_t>(z) * width], bottom, top, walkable, 1);
+                }
+            }
+        }
+    });
+
+    // 3. Walkable cells: walkable span tops with room for the agent above them
+    std::vector<Cell> cells;
+    std::vector<int> columnOffsets(columns.size() + 1, 0);
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const Column& column = columns[c];
+        for (size_t s = 0; s < column.size(); ++s) {
+            int ceiling = (s + 1 < column.size()) ? column[s + 1].bottom : INT_MAX;
+            if (!column[s].walkable || ceiling - column[s].top < headroomCells) continue;
+            cells.push_back({static_cast<int>(c % width), static_cast<int>(c / width), column[s].top, ceiling, {-1, -1, -1, -1}});
+        }
+        columnOffsets[c + 1] = static_cast<int>(cells.size());
+    }
+    columns = std::vector<Column>();
+
+    // 4. Link cells the agent can step between: small height change and shared headroom
+    parallelFor(cells.size(), threadCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Cell& cell = cells[i];
+            for (int dir = 0; dir < 4; ++dir) {
+                int nx = cell.x + DIR_X[dir];
+                int nz = cell.z + DIR_Z[dir];
+                if (nx < 0 || nz < 0 || nx >= width || nz >= depth) continue;
+                size_t column = nx + static_cast<size_t>(nz) * width;
+                int bestClimb = INT_MAX;
+                for (int n = columnOffsets[column]; n < columnOffsets[column + 1]; ++n) {
+                    const Cell& other = cells[n];
+                    int climb = std::abs(other.top - cell.top);
+                    int headroom = std::min(cell.ceiling, other.ceiling) - std::max(cell.top, other.top);
+                    if (climb <= climbCells && headroom >= headroomCells && climb < bestClimb) {
+                        bestClimb = climb;
+                        cell.neighbors[dir] = n;
+                    }
+                }
+            }
+        }
+    });
+    // Keep only links that agree in both directions
+    for (size_t i = 0; i < cells.size(); ++i) {
+        for (int dir = 0; dir < 4; ++dir) {
+            int n = cells[i].neighbors[dir];
+            if (n != -1 && cells[n].neighbors[(dir + 2) % 4] != static_cast<int>(i)) {
+                cells[i].neighbors[dir] = -1;
+            }
+        }
+    }
+
+    // 5. Erode by the agent radius: drop cells closer than radiusCells steps to an edge or wall
+    std::vector<char> removed(cells.size(), 0);
+    if (radiusCells > 0) {
+        std::vector<int> distance(cells.size(), INT_MAX);
+        std::vector<int> frontier;
+        for (size_t i = 0; i < cells.size(); ++i) {
+            const int* n = cells[i].neighbors;
+            if (n[0] == -1 || n[1] == -1 || n[2] == -1 || n[3] == -1) {
+                distance[i] = 0;
+                frontier.push_back(static_cast<int>(i));
+            }
+        }
+        for (size_t head = 0; head < frontier.size(); ++head) {
+            int current = frontier[head];
+            if (distance[current] + 1 >= radiusCells) continue;
+            for (int n : cells[current].neighbors) {
+                if (n != -1 && distance[n] == INT_MAX) {
+                    distance[n] = distance[current] + 1;
+                    frontier.push_back(n);
+                }
+            }
+        }
+        for (size_t i = 0; i < cells.size(); ++i) {
+            removed[i] = distance[i] < radiusCells;
+        }
+        for (Cell& cell : cells) {
+            for (int& n : cell.neighbors) {
+                if (n != -1 && removed[n]) n = -1;
+            }
+        }
+    }
+
+    // 6. Greedily merge cells into rectangles of roughly level ground
+    std::vector<int> polygonOf(cells.size(), -1);
+    auto cellY = [&](int cell) { return boundsMin.y + cells[cell].top * cellHeight; };
+    std::vector<std::vector<int>> rows;
+    for (size_t seed = 0; seed < cells.size(); ++seed) {
+        if (removed[seed] || polygonOf[seed] != -1) continue;
+
+        const int seedTop = cells[seed].top;
+        auto fits = [&](int n) {
+            return n != -1 && polygonOf[n] == -1 && std::abs(cells[n].top - seedTop) <= climbCells;
+        };
+
+        rows.assign(1, {static_cast<int>(seed)});
+        while (static_cast<int>(rows[0].size()) < settings.maxPolygonCells && fits(cells[rows[0].back()].neighbors[0])) {
+            rows[0].push_back(cells[rows[0].back()].neighbors[0]);
+        }
+        std::vector<int> next;
+        while (static_cast<int>(rows.size()) < settings.maxPolygonCells) {
+            next.clear();
+            for (int c : rows.back()) {
+                int n = cells[c].neighbors[1];
+                if (!fits(n) || (!next.empty() && cells[next.back()].neighbors[0] != n)) break;
+                next.push_back(n);
+            }
+            if (next.size() != rows.back().size()) break;
+            rows.push_back(next);
+        }
+
+        int polygonIndex = static_cast<int>(m_polygons.size());
+        Polygon polygon;
+        polygon.min = glm::vec2(boundsMin.x + cells[seed].x * cellSize, boundsMin.z + cells[seed].z * cellSize);
+        polygon.max = polygon.min + glm::vec2(rows[0].size() * cellSize, rows.size() * cellSize);
+        polygon.minY = std::numeric_limits<float>::max();
+        polygon.maxY = std::numeric_limits<float>::lowest();
+        float sumY = 0.0f;
+        for (const auto& rowCells : rows) {
+            for (int c : rowCells) {
+                polygonOf[c] = polygonIndex;
+                float y = cellY(c);
+                polygon.minY = std::min(polygon.minY, y);
+                polygon.maxY = std::max(polygon.maxY, y);
+                sumY += y;
+            }
+        }
+        m_walkableCellCount += rows.size() * rows[0].size();
+        glm::vec2 middle = 0.5f * (polygon.min + polygon.max);
+        polygon.center = glm::vec3(middle.x, sumY / (rows.size() * rows[0].size()), middle.y);
+        m_polygons.push_back(polygon);
+    }
+
+    // 7. Portals: the shared border of every pair of linked polygons
+    struct Border {
+        glm::vec3 low, high; // Ends of the shared edge
+        float lowT, highT;   // Their coordinate along the edge
+    };
+    std::unordered_map<uint64_t, Border> borders;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (removed[i]) continue;
+        for (int dir = 0; dir < 2; ++dir) {
+            int n = cells[i].neighbors[dir];
+            if (n == -1 || polygonOf[n] == polygonOf[i]) continue;
+
+            int a = std::min(polygonOf[i], polygonOf[n]);
+            int b = std::max(polygonOf[i], polygonOf[n]);
+            uint64_t key = (static_cast<uint64_t>(a) << 32) | static_cast<uint32_t>(b);
+
+            float y = 0.5f * (cellY(static_cast<int>(i)) + cellY(n));
+            float t0, t1;
+            glm::vec3 p0, p1;
+            if (dir == 0) {
+                float x = boundsMin.x + (cells[i].x + 1) * cellSize;
+                t0 = boundsMin.z + cells[i].z * cellSize;
+                t1 = t0 + cellSize;
+                p0 = glm::vec3(x, y, t0);
+                p1 = glm::vec3(x, y, t1);
+            } else {
+                float z = boundsMin.z + (cells[i].z + 1) * cellSize;
+                t0 = boundsMin.x + cells[i].x * cellSize;
+                t1 = t0 + cellSize;
+                p0 = glm::vec3(t0, y, z);
+                p1 = glm::vec3(t1, y, z);
+            }
+
+            auto it = borders.find(key);
+            if (it == borders.end()) {
+                borders.emplace(key, Border{p0, p1, t0, t1});
+            } else {
+                if (t0 < it->second.lowT) { it->second.low = p0; it->second.lowT = t0; }
+                if (t1 > it->second.highT) { it->second.high = p1; it->second.highT = t1; }
+            }
+        }
+    }
+
+    std::vector<std::pair<uint64_t, Border>> sortedBorders(borders.begin(), borders.end());
+    std::sort(sortedBorders.begin(), sortedBorders.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    m_portalOffsets.assign(m_polygons.size() + 1, 0);
+    for (const auto& [key, border] : sortedBorders) {
+        m_portalOffsets[(key >> 32) + 1]++;
+        m_portalOffsets[(key & 0xffffffffu) + 1]++;
+    }
+    for (size_t p = 0; p < m_polygons.size(); ++p) {
+        m_portalOffsets[p + 1] += m_portalOffsets[p];
+    }
+    m_portals.resize(m_portalOffsets.back());
+    std::vector<int> cursor(m_portalOffsets.begin(), m_portalOffsets.end() - 1);
+    for (const auto& [key, border] : sortedBorders) {
+        int a = static_cast<int>(key >> 32);
+        int b = static_cast<int>(key & 0xffffffffu);
+
+        // Seen when walking from a to b, a point is on the left if it lies counter-clockwise of the travel direction
+        glm::vec3 travel = m_polygons[b].center - m_polygons[a].center;
+        glm::vec3 middle = 0.5f * (border.low + border.high);
+        bool lowIsLeft = cross2D(travel, border.low - middle) < 0.0f;
+        const glm::vec3& left = lowIsLeft ? border.low : border.high;
+        const glm::vec3& right = lowIsLeft ? border.high : border.low;
+
+        m_portals[cursor[a]++] = {b, left, right};
+        m_portals[cursor[b]++] = {a, right, left};
+    }
+
+    buildPolygonIndex();
+    m_lastBuildTimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+}
+
+void NavMesh::buildPolygonIndex() {
+    m_bucketOffsets.clear();
+    m_bucketPolygons.clear();
+    if (m_polygons.empty()) return;
+
+    glm::vec2 boundsMin(std::numeric_limits<float>::max());
+    glm::vec2 boundsMax(std::numeric_limits<float>::lowest());
+    float largestSide = 0.0f;
+    for (const Polygon& polygon : m_polygons) {
+        boundsMin = glm::min(boundsMin, polygon.min);
+        boundsMax = glm::max(boundsMax, polygon.max);
+        largestSide = std::max(largestSide, std::max(polygon.max.x - polygon.min.x, polygon.max.y - polygon.min.y));
+    }
+
+    // Buckets at least as large as any polygon, so each polygon lands in at most four
+    m_bucketOrigin = boundsMin;
+    m_bucketSize = std::max(largestSide, 1.0f);
+    m_bucketsX = static_cast<int>((boundsMax.x - boundsMin.x) / m_bucketSize) + 1;
+    m_bucketsZ = static_cast<int>((boundsMax.y - boundsMin.y) / m_bucketSize) + 1;
+
+    auto forEachBucket = [&](const Polygon& polygon, auto&& visit) {
+        int x0 = static_cast<int>((polygon.min.x - m_bucketOrigin.x) / m_bucketSize);
+        int x1 = std::min(m_bucketsX - 1, static_cast<int>((polygon.max.x - m_bucketOrigin.x) / m_bucketSize));
+        int z0 = static_cast<int>((polygon.min.y - m_bucketOrigin.y) / m_bucketSize);
+        int z1 = std::min(m_bucketsZ - 1, static_cast<int>((polygon.max.y - m_bucketOrigin.y) / m_bucketSize));
+        for (int z = z0; z <= z1; ++z) {
+            for (int x = x0; x <= x1; ++x) {
+                visit(x + z * m_bucketsX);
+            }
+        }
+    };
+
+    m_bucketOffsets.assign(static_cast<size_t>(m_bucketsX) * m_bucketsZ + 1, 0);
+    for (const Polygon& polygon : m_polygons) {
+        forEachBucket(polygon, [&](int bucket) { m_bucketOffsets[bucket + 1]++; });
+    }
+    for (size_t b = 1; b < m_bucketOffsets.size(); ++b) {
+        m_bucketOffsets[b] += m_bucketOffsets[b - 1];
+    }
+    m_bucketPolygons.resize(m_bucketOffsets.back());
+    std::vector<int> cursor(m_bucketOffsets.begin(), m_bucketOffsets.end() - 1);
+    for (size_t p = 0; p < m_polygons.size(); ++p) {
+        forEachBucket(m_polygons[p], [&](int bucket) { m_bucketPolygons[cursor[bucket]++] = static_cast<int>(p); });
+    }
+}
+
+int NavMesh::findPolygon(const glm::vec3& position) const {
+    if (m_polygons.empty()) return -1;
+
+    int x = static_cast<int>(std::floor((position.x - m_bucketOrigin.x) / m_bucketSize));
+    int z = static_cast<int>(std::floor((position.z - m_bucketOrigin.y) / m_bucketSize));
+    if (x < 0 || z < 0 || x >= m_bucketsX || z >= m_bucketsZ) return -1;
+
+    int best = -1;
+    int bucket = x + z * m_bucketsX;
+    for (int i = m_bucketOffsets[bucket]; i < m_bucketOffsets[bucket + 1]; ++i) {
+        const Polygon& polygon = m_polygons[m_bucketPolygons[i]];
+        if (position.x < polygon.min.x || position.x > polygon.max.x ||
+            position.z < polygon.min.y || position.z > polygon.max.y) continue;
+        if (polygon.minY > position.y + m_maxStepHeight) continue;
+        if (best == -1 || polygon.minY > m_polygons[best].minY) {
+            best = m_bucketPolygons[i];
+        }
+    }
+    return best;
+}
+
+std::vector<glm::vec3> NavMesh::stringPull(const glm::vec3& start, const glm::vec3& goal,
+                                           const std::vector<int>& polygonPath) const {
+    // Portal list bracketed by zero-width portals at the start and goal
+    std::vector<std::pair<glm::vec3, glm::vec3>> portals;
+    portals.push_back({start, start});
+    for (size_t i = 0; i + 1 < polygonPath.size(); ++i) {
+        for (int slot = getPortalBegin(polygonPath[i]); slot < getPortalEnd(polygonPath[i]); ++slot) {
+            if (m_portals[slot].neighbor == polygonPath[i + 1]) {
+                portals.push_back({m_portals[slot].left, m_portals[slot].right});
+                break;
+            }
+        }
+    }
+    portals.push_back({goal, goal});
+
+    // Simple stupid funnel: narrow the left and right edges portal by portal; whenever one edge
+    // crosses the other, its tip becomes a corner of the path and the funnel restarts from there
+    std::vector<glm::vec3> path;
+    glm::vec3 apex = start, left = start, right = start;
+    size_t apexIndex = 0, leftIndex = 0, rightIndex = 0;
+
+    auto addCorner = [&path, &start](const glm::vec3& point) {
+        if ((path.empty() && point != start) || (!path.empty() && point != path.back())) {
+            path.push_back(point);
+        }
+    };
+
+    for (size_t i = 1; i < portals.size(); ++i) {
+        const glm::vec3& portalLeft = portals[i].first;
+        const glm::vec3& portalRight = portals[i].second;
+
+        // Right edge moves inward
+        if (cross2D(right - apex, portalRight - apex) <= 0.0f) {
+            if (apex == right || cross2D(left - apex, portalRight - apex) > 0.0f) {
+                right = portalRight;
+                rightIndex = i;
+            } else {
+                // Right crossed over left: left tip is a corner
+                addCorner(left);
+                apex = left;
+                apexIndex = leftIndex;
+                right = left = apex;
+                rightIndex = leftIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+
+        // Left edge moves inward
+        if (cross2D(left - apex, portalLeft - apex) >= 0.0f) {
+            if (apex == left || cross2D(right - apex, portalLeft - apex) < 0.0f) {
+                left = portalLeft;
+                leftIndex = i;
+            } else {
+                // Left crossed over right: right tip is a corner
+                addCorner(right);
+                apex = right;
+                apexIndex = rightIndex;
+                right = left = apex;
+                rightIndex = leftIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+
+    addCorner(goal);
+    if (path.empty()) {
+        path.push_back(goal);
+    }
+    return path;
+}
@@ -1,16 +1,22 @@
 #include "Systems/NavigationGraph.h"
 #include "Entities/Platform.h"
+#include "Systems/RaycastUtility.h"
+#include "Config.h"
 #include <glm/gtx/norm.hpp>
 #include <algorithm>
-#include <queue>
-#include <unordered_map>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <functional>
 #include <limits>
 
 NavigationGraph::NavigationGraph() {}
 
-void NavigationGraph::buildFromPlatforms(const std::vector<Platform>& platforms) {
-    nodes.clear();
-    edges.clear();
+void NavigationGraph::buildFromPlatforms(const std::vector<Platform>& platforms,
+                                         const AABBTree* broadphase,
+                                         bool validateEdges) {
+    auto buildStart = std::chrono::steady_clock::now();
+    reset();
     
     if (platforms.empty()) {
         return;
@@ -21,18 +27,185 @@ void NavigationGraph::buildFromPlatforms(const std::vector<Platform>& platforms)
         nodes.emplace_back(platforms[i].getPosition(), static_cast<int>(i));
     }
     
-    // Create edges between nearby platforms
+    // The spatial index doubles as the neighbour search for edge construction
+    std::vector<glm::vec3> positions;
+    positions.reserve(nodes.size());
+    for (const NavNode& node : nodes) {
+        positions.push_back(node.position);
+    }
+    nodeIndex.build(positions);
+    
+    // Gather each platform pair within walking distance once (i < j), in ascending order
+    std::vector<std::pair<int, int>> candidates;
+    std::vector<int> nearby;
     for (size_t i = 0; i < nodes.size(); ++i) {
-        for (size_t j = i + 1; j < nodes.size(); ++j) {
-            float distance = glm::distance(nodes[i].position, nodes[j].position);
-            
-            // Only connect platforms within walking distance
-            if (distance <= MAX_WALK_DISTANCE) {
-                edges.emplace_back(i, j, distance);
-                edges.emplace_back(j, i, distance); // Bidirectional
+        nodeIndex.withinRadius(nodes[i].position, MAX_WALK_DISTANCE, nearby);
+        std::sort(nearby.begin(), nearby.end());
+        for (int j : nearby) {
+            if (j > static_cast<int>(i)) {
+                candidates.push_back({static_cast<int>(i), j});
             }
         }
     }
+    
+    std::vector<char> keep(candidates.size(), 1);
+    if (validateEdges) {
+        validateCandidateEdges(platforms, broadphase, candidates, keep);
+    }
+    
+    // Create edges between nearby platforms
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        if (!keep[c]) {
+            rejectedEdgeCount++;
+            continue;
+        }
+        int i = candidates[c].first;
+        int j = candidates[c].second;
+        float distance = glm::distance(nodes[i].position, nodes[j].position);
+        edges.emplace_back(i, j, distance);
+        edges.emplace_back(j, i, distance); // Bidirectional
+    }
+    
+    finishBuild(buildStart);
+}
+
+void NavigationGraph::buildFromNavMesh(NavMesh&& mesh) {
+    auto buildStart = std::chrono::steady_clock::now();
+    reset();
+    navMesh = std::move(mesh);
+    
+    const auto& polygons = navMesh.getPolygons();
+    if (polygons.empty()) {
+        return;
+    }
+    
+    std::vector<glm::vec3> positions;
+    positions.reserve(polygons.size());
+    for (const NavMesh::Polygon& polygon : polygons) {
+        nodes.emplace_back(polygon.center, -1);
+        positions.push_back(polygon.center);
+    }
+    nodeIndex.build(positions);
+    
+    // Portals come in matching pairs, so every edge gets its reverse twin
+    for (int p = 0; p < static_cast<int>(polygons.size()); ++p) {
+        for (int slot = navMesh.getPortalBegin(p); slot < navMesh.getPortalEnd(p); ++slot) {
+            const NavMesh::Portal& portal = navMesh.getPortal(slot);
+            glm::vec3 crossing = 0.5f * (portal.left + portal.right);
+            float cost = glm::distance(polygons[p].center, crossing) + glm::distance(crossing, polygons[portal.neighbor].center);
+            edges.emplace_back(p, portal.neighbor, cost);
+        }
+    }
+    
+    finishBuild(buildStart);
+}
+
+void NavigationGraph::reset() {
+    lastBuildTimeMs = 0.0f;
+    rejectedEdgeCount = 0;
+    
+    nodes.clear();
+    edges.clear();
+    adjacencyOffsets.clear();
+    adjacencyTargets.clear();
+    adjacencyCosts.clear();
+    nodeIndex.clear();
+    nextHopTable.clear();
+    navMesh.clear();
+    hierarchy.clear();
+}
+
+void NavigationGraph::finishBuild(std::chrono::steady_clock::time_point buildStart) {
+    buildAdjacency();
+    
+    if (nodes.size() >= static_cast<size_t>(Config::NAV_HIERARCHY_MIN_NODES)) {
+        hierarchy.build(*this, Config::NAV_CLUSTER_SIZE);
+    }
+    
+    lastBuildTimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+}
+
+void NavigationGraph::validateCandidateEdges(const std::vector<Platform>& platforms,
+                                             const AABBTree* broadphase,
+                                             const std::vector<std::pair<int, int>>& candidates,
+                                             std::vector<char>& keep) const {
+    // Probe from roughly eye height above each platform's top surface
+    auto probePoint = [&](int node) {
+        const Platform& platform = platforms[nodes[node].platformIndex];
+        float top = platform.getPosition().y + platform.getSize().y * 0.5f;
+        glm::vec3 p = nodes[node].position;
+        p.y = top + Config::SPAWN_HALF_HEIGHT + Config::EYE_HEIGHT;
+        return p;
+    };
+    
+    auto validateRange = [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            glm::vec3 a = probePoint(candidates[c].first);
+            glm::vec3 b = probePoint(candidates[c].second);
+            
+            bool walkable = std::abs(a.y - b.y) <= Config::NAV_MAX_STEP_HEIGHT;
+            keep[c] = walkable && RaycastUtility::hasLineOfSight(a, b, platforms, broadphase);
+        }
+    };
+    
+    // Every candidate is independent and the platform queries are read-only, so split the list across threads
+    size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, std::max<size_t>(1, candidates.size() / MIN_EDGES_PER_THREAD));
+    if (threadCount <= 1) {
+        validateRange(0, candidates.size());
+        return;
+    }
+    
+    std::vector<std::thread> workers;
+    size_t chunk = (candidates.size() + threadCount - 1) / threadCount;
+    for (size_t t = 0; t < threadCount; ++t) {
+        size_t begin = t * chunk;
+        size_t end = std::min(candidates.size(), begin + chunk);
+        if (begin >= end) break;
+        workers.emplace_back(validateRange, begin, end);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void NavigationGraph::buildAdjacency() {
+    adjacencyOffsets.assign(nodes.size() + 1, 0);
+    for (const NavEdge& edge : edges) {
+        adjacencyOffsets[edge.fromNode + 1]++;
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+    }
+    
+    adjacencyTargets.resize(edges.size());
+    adjacencyCosts.resize(edges.size());
+    std::vector<int> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (const NavEdge& edge : edges) {
+        int slot = cursor[edge.fromNode]++;
+        adjacencyTargets[slot] = edge.toNode;
+        adjacencyCosts[slot] = edge.cost;
+    }
+}
+
+void NavigationGraph::SearchScratch::begin(size_t nodeCount) {
+    if (generation.size() < nodeCount) {
+        gScore.resize(nodeCount);
+        cameFrom.resize(nodeCount);
+        generation.resize(nodeCount, 0);
+    }
+    if (++currentGeneration == 0) {
+        // Counter wrapped; old stamps could alias the new generation
+        std::fill(generation.begin(), generation.end(), 0u);
+        currentGeneration = 1;
+    }
+    openHeap.clear();
+}
+
+NavigationGraph::SearchScratch& NavigationGraph::getSearchScratch() {
+    // One per thread so const queries stay safe to run concurrently
+    static thread_local SearchScratch scratch;
+    return scratch;
 }
 
 std::vector<glm::vec3> NavigationGraph::findPath(const glm::vec3& start, const glm::vec3& goal) const {
@@ -52,106 +225,184 @@ std::vector<glm::vec3> NavigationGraph::findPath(const glm::vec3& start, const g
         return {goal};
     }
     
-    // A* algorithm
-    std::priority_queue<
-        std::pair<float, int>,
-        std::vector<std::pair<float, int>>,
-        std::greater<std::pair<float, int>>
-    > openSet;
+    std::vector<int> nodeSequence;
+    if (!findNodeSequence(startNode, goalNode, nodeSequence)) {
+        return {};
+    }
+    return buildWaypoints(start, goal, nodeSequence);
+}
+
+std::vector<glm::vec3> NavigationGraph::findNodePath(int startNode, int goalNode) const {
+    std::vector<int> nodePath;
+    if (!findNodeSequence(startNode, goalNode, nodePath)) {
+        return {};
+    }
     
-    std::unordered_map<int, float> gScore;
-    std::unordered_map<int, float> fScore;
-    std::unordered_map<int, int> cameFrom;
+    std::vector<glm::vec3> path;
+    path.reserve(nodePath.size());
+    for (int node : nodePath) {
+        path.push_back(nodes[node].position);
+    }
+    return path;
+}
+
+bool NavigationGraph::findNodeSequence(int startNode, int goalNode, std::vector<int>& outNodes) const {
+    outNodes.clear();
+    if (startNode < 0 || goalNode < 0 ||
+        startNode >= static_cast<int>(nodes.size()) || goalNode >= static_cast<int>(nodes.size())) {
+        return false;
+    }
     
-    // Initialize scores
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        gScore[i] = std::numeric_limits<float>::infinity();
-        fScore[i] = std::numeric_limits<float>::infinity();
+    if (!nextHopTable.empty()) {
+        return walkNextHopTable(startNode, goalNode, outNodes);
+    }
+    return findNodePathWithin(startNode, goalNode, [](int) { return true; }, outNodes);
+}
+
+std::vector<glm::vec3> NavigationGraph::buildWaypoints(const glm::vec3& start, const glm::vec3& goal,
+                                                       const std::vector<int>& nodeSequence) const {
+    if (!navMesh.empty()) {
+        return navMesh.stringPull(start, goal, nodeSequence);
+    }
+    
+    std::vector<glm::vec3> path;
+    path.reserve(nodeSequence.size() + 1);
+    for (int node : nodeSequence) {
+        path.push_back(nodes[node].position);
+    }
+    // Add final goal position
+    path.push_back(goal);
+    return path;
+}
+
+void NavigationGraph::computeFlowField(int targetNode, std::vector<int>& nextHop, std::vector<float>& costToTarget) const {
+    nextHop.assign(nodes.size(), -1);
+    costToTarget.assign(nodes.size(), std::numeric_limits<float>::infinity());
+    if (targetNode < 0 || targetNode >= static_cast<int>(nodes.size())) {
+        return;
     }
     
-    gScore[startNode] = 0.0f;
-    fScore[startNode] = heuristic(nodes[startNode].position, nodes[goalNode].position);
-    openSet.push({fScore[startNode], startNode});
+    SearchScratch& scratch = getSearchScratch();
+    scratch.begin(nodes.size());
+    auto& openHeap = scratch.openHeap;
+    const auto compare = std::greater<std::pair<float, int>>();
     
-    while (!openSet.empty()) {
-        int current = openSet.top().second;
-        openSet.pop();
+    costToTarget[targetNode] = 0.0f;
+    openHeap.push_back({0.0f, targetNode});
+    
+    while (!openHeap.empty()) {
+        std::pop_heap(openHeap.begin(), openHeap.end(), compare);
+        auto [cost, current] = openHeap.back();
+        openHeap.pop_back();
         
-        if (current == goalNode) {
-            // Reconstruct path
-            std::vector<int> pathIndices;
-            pathIndices.push_back(current);
-            while (cameFrom.find(current) != cameFrom.end()) {
-                current = cameFrom[current];
-                pathIndices.push_back(current);
-            }
-            std::reverse(pathIndices.begin(), pathIndices.end());
-            
-            // Convert to positions
-            std::vector<glm::vec3> path;
-            for (int idx : pathIndices) {
-                path.push_back(nodes[idx].position);
-            }
-            // Add final goal position
-            path.push_back(goal);
-            return path;
+        if (cost > costToTarget[current]) {
+            continue;
         }
         
-        // Check all neighbors
-        for (const NavEdge& edge : edges) {
-            if (edge.fromNode != current) continue;
-            
-            int neighbor = edge.toNode;
-            float tentativeGScore = gScore[current] + edge.cost;
-            
-            if (tentativeGScore < gScore[neighbor]) {
-                cameFrom[neighbor] = current;
-                gScore[neighbor] = tentativeGScore;
-                fScore[neighbor] = gScore[neighbor] + heuristic(nodes[neighbor].position, nodes[goalNode].position);
-                openSet.push({fScore[neighbor], neighbor});
+        for (int e = adjacencyOffsets[current]; e < adjacencyOffsets[current + 1]; ++e) {
+            int neighbor = adjacencyTargets[e];
+            float tentative = cost + adjacencyCosts[e];
+            if (tentative < costToTarget[neighbor]) {
+                costToTarget[neighbor] = tentative;
+                // Walking the edge back from neighbor leads toward the target through current
+                nextHop[neighbor] = current;
+                openHeap.push_back({tentative, neighbor});
+                std::push_heap(openHeap.begin(), openHeap.end(), compare);
             }
         }
     }
-    
-    // No path found
-    return {};
 }
 
 int NavigationGraph::getClosestNode(const glm::vec3& position) const {
-    if (nodes.empty()) {
-        return -1;
+    // Navmesh nodes are polygons; prefer the one actually underfoot over the nearest centre
+    if (!navMesh.empty()) {
+        int polygon = navMesh.findPolygon(position);
+        if (polygon != -1) {
+            return polygon;
+        }
     }
+    return nodeIndex.nearest(position);
+}
+
+std::vector<int> NavigationGraph::getClosestNodes(const glm::vec3& position, size_t k) const {
+    std::vector<int> result;
+    nodeIndex.kNearest(position, k, result);
+    return result;
+}
+
+std::vector<int> NavigationGraph::getNodesInRadius(const glm::vec3& position, float radius) const {
+    std::vector<int> result;
+    nodeIndex.withinRadius(position, radius, result);
+    return result;
+}
+
+bool NavigationGraph::walkNextHopTable(int startNode, int goalNode, std::vector<int>& outNodes) const {
+    outNodes.clear();
+    outNodes.push_back(startNode);
     
-    int closestIndex = 0;
-    float closestDistSq = glm::distance2(position, nodes[0].position);
-    
-    for (size_t i = 1; i < nodes.size(); ++i) {
-        float distSq = glm::distance2(position, nodes[i].position);
-        if (distSq < closestDistSq) {
-            closestDistSq = distSq;
-            closestIndex = i;
+    int current = startNode;
+    // A valid table never revisits a node, so n steps is a hard upper bound
+    for (size_t steps = 0; current != goalNode && steps < nodes.size(); ++steps) {
+        current = nextHopTable.getNextHop(current, goalNode);
+        if (current == -1) {
+            outNodes.clear();
+            return false;
         }
+        outNodes.push_back(current);
     }
     
-    return closestIndex;
+    if (current != goalNode) {
+        outNodes.clear();
+        return false;
+    }
+    return true;
 }
 
-float NavigationGraph::heuristic(const glm::vec3& a, const glm::vec3& b) const {
-    return glm::distance(a, b);
+bool NavigationGraph::bakeNextHopTable() {
+    return nextHopTable.build(*this);
 }
 
-std::vector<int> NavigationGraph::getNeighbors(int nodeIndex) const {
-    std::vector<int> neighbors;
-    for (const NavEdge& edge : edges) {
-        if (edge.fromNode == nodeIndex) {
-            neighbors.push_back(edge.toNode);
+bool NavigationGraph::saveNextHopTable(const std::string& path) const {
+    return nextHopTable.save(path, computeSignature());
+}
+
+bool NavigationGraph::loadNextHopTable(const std::string& path) {
+    if (!nextHopTable.load(path, computeSignature())) {
+        return false;
+    }
+    if (nextHopTable.getNodeCount() != nodes.size()) {
+        nextHopTable.clear();
+        return false;
+    }
+    return true;
+}
+
+uint64_t NavigationGraph::computeSignature() const {
+    // FNV-1a over the raw node positions and edge endpoints
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
         }
+    };
+    
+    uint64_t counts[2] = {nodes.size(), edges.size()};
+    mix(counts, sizeof(counts));
+    for (const NavNode& node : nodes) {
+        mix(&node.position.x, sizeof(float));
+        mix(&node.position.y, sizeof(float));
+        mix(&node.position.z, sizeof(float));
+    }
+    for (const NavEdge& edge : edges) {
+        mix(&edge.fromNode, sizeof(edge.fromNode));
+        mix(&edge.toNode, sizeof(edge.toNode));
     }
-    return neighbors;
+    return hash;
 }
 
-std::vector<glm::vec3> NavigationGraph::reconstructPath(const std::vector<int>& cameFrom, int current) const {
-    std::vector<glm::vec3> path;
-    // This helper is not currently used but kept for potential future use
-    return path;
+std::vector<int> NavigationGraph::getNeighbors(int nodeIndex) const {
+    return std::vector<int>(adjacencyTargets.begin() + adjacencyOffsets[nodeIndex],
+                            adjacencyTargets.begin() + adjacencyOffsets[nodeIndex + 1]);
 }
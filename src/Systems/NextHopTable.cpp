@@ -0,0 +1,154 @@
+#include "Systems/NextHopTable.h"
+#include "Systems/NavigationGraph.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+bool NextHopTable::build(const NavigationGraph& graph) {
+    clear();
+
+    const size_t n = graph.getNodes().size();
+    if (n == 0 || n > MAX_NODES) {
+        if (n > MAX_NODES) {
+            std::cerr << "[NextHopTable] Graph has " << n << " nodes; the 16-bit table supports at most " << MAX_NODES << std::endl;
+        }
+        return false;
+    }
+
+    // Each Dijkstra from a target yields one column: the next hop toward it from every node
+    std::vector<float> distances(n * n);
+    std::vector<uint16_t> nextHop(n * n, NO_NODE);
+
+    auto buildColumns = [&](size_t begin, size_t end) {
+        std::vector<int> columnNext;
+        std::vector<float> columnCost;
+        for (size_t target = begin; target < end; ++target) {
+            graph.computeFlowField(static_cast<int>(target), columnNext, columnCost);
+            for (size_t from = 0; from < n; ++from) {
+                nextHop[from * n + target] = columnNext[from] < 0 ? NO_NODE : static_cast<uint16_t>(columnNext[from]);
+                distances[from * n + target] = columnCost[from];
+            }
+        }
+    };
+
+    size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, n);
+    std::vector<std::thread> workers;
+    size_t chunk = (n + threadCount - 1) / threadCount;
+    for (size_t t = 0; t < threadCount; ++t) {
+        size_t begin = t * chunk;
+        size_t end = std::min(n, begin + chunk);
+        if (begin >= end) break;
+        workers.emplace_back(buildColumns, begin, end);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Quantize costs so the largest finite one maps just below the UNREACHABLE sentinel
+    float maxDistance = 0.0f;
+    for (float d : distances) {
+        if (std::isfinite(d)) maxDistance = std::max(maxDistance, d);
+    }
+    m_distanceScale = maxDistance > 0.0f ? maxDistance / static_cast<float>(UNREACHABLE - 1) : 1.0f;
+
+    m_distance.resize(n * n);
+    for (size_t i = 0; i < distances.size(); ++i) {
+        m_distance[i] = std::isfinite(distances[i])
+            ? static_cast<uint16_t>(std::lround(distances[i] / m_distanceScale))
+            : UNREACHABLE;
+    }
+
+    m_nextHop = std::move(nextHop);
+    m_nodeCount = n;
+    return true;
+}
+
+bool NextHopTable::save(const std::string& path, uint64_t graphSignature) const {
+    if (empty()) {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "[NextHopTable] Could not write " << path << std::endl;
+        return false;
+    }
+
+    // Native byte order; the table is baked on and shipped for little-endian targets
+    uint32_t nodeCount = static_cast<uint32_t>(m_nodeCount);
+    file.write(reinterpret_cast<const char*>(&FILE_MAGIC), sizeof(FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&FILE_VERSION), sizeof(FILE_VERSION));
+    file.write(reinterpret_cast<const char*>(&graphSignature), sizeof(graphSignature));
+    file.write(reinterpret_cast<const char*>(&nodeCount), sizeof(nodeCount));
+    file.write(reinterpret_cast<const char*>(&m_distanceScale), sizeof(m_distanceScale));
+    file.write(reinterpret_cast<const char*>(m_nextHop.data()), m_nextHop.size() * sizeof(uint16_t));
+    file.write(reinterpret_cast<const char*>(m_distance.data()), m_distance.size() * sizeof(uint16_t));
+    return static_cast<bool>(file);
+}
+
+bool NextHopTable::load(const std::string& path, uint64_t graphSignature) {
+    clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    uint32_t magic = 0, version = 0, nodeCount = 0;
+    uint64_t signature = 0;
+    float distanceScale = 0.0f;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&signature), sizeof(signature));
+    file.read(reinterpret_cast<char*>(&nodeCount), sizeof(nodeCount));
+    file.read(reinterpret_cast<char*>(&distanceScale), sizeof(distanceScale));
+
+    if (!file || magic != FILE_MAGIC || version != FILE_VERSION) {
+        std::cerr << "[NextHopTable] " << path << " is not a valid table" << std::endl;
+        return false;
+    }
+    if (signature != graphSignature || nodeCount == 0 || nodeCount > MAX_NODES) {
+        std::cerr << "[NextHopTable] " << path << " was baked for a different graph; ignoring it" << std::endl;
+        return false;
+    }
+
+    size_t entries = static_cast<size_t>(nodeCount) * nodeCount;
+    m_nextHop.resize(entries);
+    m_distance.resize(entries);
+    file.read(reinterpret_cast<char*>(m_nextHop.data()), entries * sizeof(uint16_t));
+    file.read(reinterpret_cast<char*>(m_distance.data()), entries * sizeof(uint16_t));
+    if (!file) {
+        std::cerr << "[NextHopTable] " << path << " is truncated" << std::endl;
+        clear();
+        return false;
+    }
+
+    // getNextHop() results index nav nodes directly, so every entry must be a node or NO_NODE
+    for (uint16_t next : m_nextHop) {
+        if (next != NO_NODE && next >= nodeCount) {
+            std::cerr << "[NextHopTable] " << path << " has a next hop outside the graph" << std::endl;
+            clear();
+            return false;
+        }
+    }
+
+    m_nodeCount = nodeCount;
+    m_distanceScale = distanceScale;
+    return true;
+}
+
+void NextHopTable::clear() {
+    m_nodeCount = 0;
+    m_distanceScale = 0.0f;
+    m_nextHop.clear();
+    m_distance.clear();
+}
+
+float NextHopTable::getDistance(int from, int to) const {
+    uint16_t d = m_distance[static_cast<size_t>(from) * m_nodeCount + to];
+    return d == UNREACHABLE ? std::numeric_limits<float>::infinity() : d * m_distanceScale;
+}
@@ -0,0 +1,188 @@
+#include "Systems/ParticlePool.h"
+#include <algorithm>
+#include <iterator>
+
+// SSE2 is part of the x86-64 baseline, so no runtime dispatch is needed here
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_POOL_SSE2
+#include <emmintrin.h>
+#endif
+
+ParticlePool::ParticlePool(size_t capacity)
+    : m_capacity(capacity), m_count(0), m_categoryCounts{} {
+    for (std::vector<float>* stream : {&m_posX, &m_posY, &m_posZ, &m_velX, &m_velY, &m_velZ,
+                                       &m_colorR, &m_colorG, &m_colorB, &m_alpha,
+                                       &m_life, &m_invInitialLife, &m_initialAlpha, &m_size}) {
+        stream->resize(capacity);
+    }
+    m_category.resize(capacity);
+    m_older.resize(capacity);
+    m_newer.resize(capacity);
+    clear();
+}
+
+void ParticlePool::clear() {
+    m_count = 0;
+    std::fill(std::begin(m_categoryCounts), std::end(m_categoryCounts), 0);
+    std::fill(std::begin(m_oldest), std::end(m_oldest), NO_PARTICLE);
+    std::fill(std::begin(m_newest), std::end(m_newest), NO_PARTICLE);
+}
+
+bool ParticlePool::add(const glm::vec3& position, const glm::vec3& velocity, const glm::vec4& color, float life, float size,
+                       ParticleCategory category) {
+    if (m_count >= m_capacity) {
+        return false;
+    }
+
+    size_t i = m_count++;
+    m_posX[i] = position.x;
+    m_posY[i] = position.y;
+    m_posZ[i] = position.z;
+    m_velX[i] = velocity.x;
+    m_velY[i] = velocity.y;
+    m_velZ[i] = velocity.z;
+    m_colorR[i] = color.r;
+    m_colorG[i] = color.g;
+    m_colorB[i] = color.b;
+    m_alpha[i] = color.a;
+    m_life[i] = life;
+    m_invInitialLife[i] = 1.0f / std::max(life, 0.0001f);
+    m_initialAlpha[i] = color.a;
+    m_size[i] = size;
+    m_category[i] = static_cast<uint8_t>(category);
+
+    // Newest end of the category's age list
+    int c = static_cast<int>(category);
+    m_older[i] = m_newest[c];
+    m_newer[i] = NO_PARTICLE;
+    if (m_newest[c] != NO_PARTICLE) {
+        m_newer[m_newest[c]] = static_cast<int32_t>(i);
+    } else {
+        m_oldest[c] = static_cast<int32_t>(i);
+    }
+    m_newest[c] = static_cast<int32_t>(i);
+    m_categoryCounts[c]++;
+    return true;
+}
+
+size_t ParticlePool::evictOldest(ParticleCategory category, size_t count) {
+    int c = static_cast<int>(category);
+    size_t evicted = 0;
+    while (evicted < count && m_oldest[c] != NO_PARTICLE) {
+        removeAt(static_cast<size_t>(m_oldest[c]));
+        evicted++;
+    }
+    return evicted;
+}
+
+void ParticlePool::update(float deltaTime, float gravity) {
+    const size_t count = m_count;
+    float* posX = m_posX.data();
+    float* posY = m_posY.data();
+    float* posZ = m_posZ.data();
+    const float* velX = m_velX.data();
+    float* velY = m_velY.data();
+    const float* velZ = m_velZ.data();
+    float* alpha = m_alpha.data();
+    float* life = m_life.data();
+    const float* invInitialLife = m_invInitialLife.data();
+    const float* initialAlpha = m_initialAlpha.data();
+    const float gravityStep = gravity * deltaTime;
+
+    // Particles that expire this tick are integrated too; they are removed right after
+    size_t i = 0;
+#ifdef PARTICLE_POOL_SSE2
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 gravityStep4 = _mm_set1_ps(gravityStep);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 vy = _mm_loadu_ps(velY + i);
+        _mm_storeu_ps(posX + i, _mm_add_ps(_mm_loadu_ps(posX + i), _mm_mul_ps(_mm_loadu_ps(velX + i), dt)));
+        _mm_storeu_ps(posY + i, _mm_add_ps(_mm_loadu_ps(posY + i), _mm_mul_ps(vy, dt)));
+        _mm_storeu_ps(posZ + i, _mm_add_ps(_mm_loadu_ps(posZ + i), _mm_mul_ps(_mm_loadu_ps(velZ + i), dt)));
+        _mm_storeu_ps(velY + i, _mm_sub_ps(vy, gravityStep4));
+
+        __m128 remaining = _mm_sub_ps(_mm_loadu_ps(life + i), dt);
+        _mm_storeu_ps(life + i, remaining);
+        __m128 lifeRatio = _mm_min_ps(_mm_max_ps(_mm_mul_ps(remaining, _mm_loadu_ps(invInitialLife + i)), zero), one);
+        __m128 faded = _mm_mul_ps(_mm_loadu_ps(initialAlpha + i), lifeRatio);
+        _mm_storeu_ps(alpha + i, _mm_min_ps(_mm_max_ps(faded, zero), one));
+    }
+#endif
+    for (; i < count; ++i) {
+        posX[i] += velX[i] * deltaTime;
+        posY[i] += velY[i] * deltaTime;
+        posZ[i] += velZ[i] * deltaTime;
+        velY[i] -= gravityStep;
+
+        life[i] -= deltaTime;
+        float lifeRatio = std::min(std::max(life[i] * invInitialLife[i], 0.0f), 1.0f);
+        alpha[i] = std::min(std::max(initialAlpha[i] * lifeRatio, 0.0f), 1.0f);
+    }
+
+    // Swap-remove: the moved-in particle is already updated, so re-check the same slot
+    for (size_t slot = 0; slot < m_count;) {
+        if (m_life[slot] <= 0.0f) {
+            removeAt(slot);
+        } else {
+            ++slot;
+        }
+    }
+}
+
+void ParticlePool::unlink(size_t index) {
+    int c = m_category[index];
+    int32_t older = m_older[index];
+    int32_t newer = m_newer[index];
+    if (older != NO_PARTICLE) {
+        m_newer[older] = newer;
+    } else {
+        m_oldest[c] = newer;
+    }
+    if (newer != NO_PARTICLE) {
+        m_older[newer] = older;
+    } else {
+        m_newest[c] = older;
+    }
+}
+
+void ParticlePool::removeAt(size_t index) {
+    unlink(index);
+    m_categoryCounts[m_category[index]]--;
+    size_t last = --m_count;
+    if (index == last) {
+        return;
+    }
+    m_posX[index] = m_posX[last];
+    m_posY[index] = m_posY[last];
+    m_posZ[index] = m_posZ[last];
+    m_velX[index] = m_velX[last];
+    m_velY[index] = m_velY[last];
+    m_velZ[index] = m_velZ[last];
+    m_colorR[index] = m_colorR[last];
+    m_colorG[index] = m_colorG[last];
+    m_colorB[index] = m_colorB[last];
+    m_alpha[index] = m_alpha[last];
+    m_life[index] = m_life[last];
+    m_invInitialLife[index] = m_invInitialLife[last];
+    m_initialAlpha[index] = m_initialAlpha[last];
+    m_size[index] = m_size[last];
+    m_category[index] = m_category[last];
+    m_older[index] = m_older[last];
+    m_newer[index] = m_newer[last];
+
+    // Point the moved particle's age-list neighbours at its new slot
+    int c = m_category[index];
+    int32_t moved = static_cast<int32_t>(index);
+    if (m_older[index] != NO_PARTICLE) {
+        m_newer[m_older[index]] = moved;
+    } else {
+        m_oldest[c] = moved;
+    }
+    if (m_newer[index] != NO_PARTICLE) {
+        m_older[m_newer[index]] = moved;
+    } else {
+        m_newest[c] = moved;
+    }
+}
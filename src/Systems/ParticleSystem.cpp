@@ -1,20 +1,48 @@
 #include "ParticleSystem.h"
 #include "Shader.h"
+#include "Config.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/norm.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+
+namespace {
+struct CategoryBudget {
+    int maxParticles;
+    int priority; // Higher survives longer when the pool is full
+};
+
+// Indexed by ParticleCategory
+const CategoryBudget CATEGORY_BUDGETS[] = {
+    {Config::PARTICLE_BUDGET_ATMOSPHERIC, Config::PARTICLE_PRIORITY_ATMOSPHERIC},
+    {Config::PARTICLE_BUDGET_MUZZLE, Config::PARTICLE_PRIORITY_MUZZLE},
+    {Config::PARTICLE_BUDGET_IMPACT, Config::PARTICLE_PRIORITY_IMPACT},
+    {Config::PARTICLE_BUDGET_SMOKE, Config::PARTICLE_PRIORITY_SMOKE},
+};
+static_assert(sizeof(CATEGORY_BUDGETS) / sizeof(CATEGORY_BUDGETS[0]) == static_cast<size_t>(ParticleCategory::Count),
+              "every particle category needs a budget");
+
+const CategoryBudget& budgetFor(ParticleCategory category) {
+    return CATEGORY_BUDGETS[static_cast<int>(category)];
+}
+}
 
 ParticleSystem::ParticleSystem(int maxParticles) 
-    : maxParticles(maxParticles), rng(std::random_device{}()) {
-    particles.reserve(maxParticles);
+    : particles(static_cast<size_t>(std::max(0, maxParticles))), maxParticles(maxParticles),
+      rng(std::random_device{}() | (static_cast<uint64_t>(std::random_device{}()) << 32)) {
+    instanceData.reserve(maxParticles);
     setupBuffers();
 }
 
 ParticleSystem::~ParticleSystem() {
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &instanceVBO);
+    releaseGpu();
 }
 
 void ParticleSystem::setupBuffers() {
@@ -35,6 +63,19 @@ void ParticleSystem::setupBuffers() {
     
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+
+    // One ParticleInstance per particle, advanced once per instance instead of per vertex
+    glGenBuffers(1, &instanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, maxParticles * sizeof(ParticleInstance), nullptr, GL_STREAM_DRAW);
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)offsetof(ParticleInstance, positionSize));
+    glVertexAttribDivisor(1, 1);
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)offsetof(ParticleInstance, color));
+    glVertexAttribDivisor(2, 1);
     
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
@@ -47,10 +88,13 @@ void ParticleSystem::update(float deltaTime) {
 
 void ParticleSystem::update(float deltaTime, const glm::vec3& center) {
     // Atmospheric spawning (spawn near provided center, typically camera)
-    if (atmosphereEnabled && atmosphereRate > 0) {
+    atmosphereTime = std::fmod(atmosphereTime + deltaTime, ATMOSPHERE_PERIOD);
+    viewCenter = center;
+    if (atmosphereEnabled && !atmosphereProcedural && atmosphereRate > 0) {
         atmosphereAccumulator += deltaTime * static_cast<float>(atmosphereRate);
         int toSpawn = static_cast<int>(floor(atmosphereAccumulator));
         atmosphereAccumulator -= static_cast<float>(toSpawn);
+        toSpawn = reserve(ParticleCategory::Atmospheric, toSpawn);
 
         for (int i = 0; i < toSpawn; ++i) {
             const float PI = 3.14159265f;
@@ -64,37 +108,50 @@ void ParticleSystem::update(float deltaTime, const glm::vec3& center) {
             glm::vec3 pos = center + glm::vec3(x, y, z);
             glm::vec3 vel = glm::vec3(randomFloat(-0.05f, 0.05f), randomFloat(0.01f, 0.12f), randomFloat(-0.05f, 0.05f));
             glm::vec4 color = glm::vec4(randomFloat(0.85f, 1.0f), randomFloat(0.85f, 1.0f), randomFloat(0.9f, 1.0f), randomFloat(0.04f, 0.18f));
-            emitParticle(pos, vel, color, randomFloat(3.0f, 7.0f), randomFloat(0.05f, 0.25f));
+            emitParticle(ParticleCategory::Atmospheric, pos, vel, color, randomFloat(3.0f, 7.0f), randomFloat(0.05f, 0.25f));
         }
     }
 
-    // Update all particles
-    for (auto& particle : particles) {
-        particle.life -= deltaTime;
-        if (particle.life > 0.0f) {
-            particle.position += particle.velocity * deltaTime;
-            // Reduced gravity effect for small particles
-            particle.velocity.y -= 9.8f * 0.1f * deltaTime;
-
-            // Smooth fade based on initial life and initial alpha
-            if (particle.initialLife > 0.0001f) {
-                float lifeRatio = particle.life / particle.initialLife;
-                lifeRatio = glm::clamp(lifeRatio, 0.0f, 1.0f);
-                particle.color.a = glm::clamp(particle.initialAlpha * lifeRatio, 0.0f, 1.0f);
-            } else {
-                particle.color.a = glm::clamp(particle.color.a - deltaTime, 0.0f, 1.0f);
-            }
-        }
+    if (gpuSimulation) {
+        simulateGpu(deltaTime);
+    } else {
+        particles.update(deltaTime, GRAVITY);
     }
-    
-    // Remove dead particles
-    particles.erase(
-        std::remove_if(particles.begin(), particles.end(),
-            [](const Particle& p) { return p.life <= 0.0f; }),
-        particles.end()
-    );
 }
+
 void ParticleSystem::draw(const glm::mat4& projection, const glm::mat4& view, Shader& shader) {
+    if (atmosphereEnabled && atmosphereProcedural) {
+        drawAtmosphere(projection, view);
+    }
+    if (gpuSimulation) {
+        drawGpu(projection, view);
+        return;
+    }
+
+    // The pool only holds live particles, so every entry is drawn
+    size_t count = particles.size();
+    if (count == 0) return;
+
+    instanceData.resize(count);
+    const float* posX = particles.getPositionX();
+    const float* posY = particles.getPositionY();
+    const float* posZ = particles.getPositionZ();
+    const float* sizes = particles.getSize();
+    const float* colorR = particles.getColorR();
+    const float* colorG = particles.getColorG();
+    const float* colorB = particles.getColorB();
+    const float* alpha = particles.getAlpha();
+    for (size_t i = 0; i < count; ++i) {
+        instanceData[i].positionSize = glm::vec4(posX[i], posY[i], posZ[i], sizes[i]);
+        instanceData[i].color = glm::vec4(colorR[i], colorG[i], colorB[i], alpha[i]);
+    }
+
+    // Orphan last frame's storage so the upload never waits on draws still using it
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, maxParticles * sizeof(ParticleInstance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instanceData.size() * sizeof(ParticleInstance), instanceData.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
     shader.use();
     shader.setMat4("projection", projection);
     shader.setMat4("view", view);
@@ -103,13 +160,7 @@ void ParticleSystem::draw(const glm::mat4& projection, const glm::mat4& view, Sh
     glDepthMask(GL_FALSE);
 
     glBindVertexArray(VAO);
-    for (const auto& particle : particles) {
-        if (particle.life <= 0.0f) continue;
-        shader.setVec3("particlePos", particle.position);
-        shader.setFloat("particleSize", particle.size);
-        shader.setVec4("particleColor", particle.color);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    }
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, static_cast<GLsizei>(instanceData.size()));
     glBindVertexArray(0);
 
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -117,6 +168,7 @@ void ParticleSystem::draw(const glm::mat4& projection, const glm::mat4& view, Sh
 }
 
 void ParticleSystem::emitExplosion(glm::vec3 position, int count) {
+    count = reserve(ParticleCategory::Impact, scaleEmission(ParticleCategory::Impact, position, count));
     for (int i = 0; i < count; ++i) {
         float angle = randomFloat(0.0f, 6.28318f);
         float speed = randomFloat(2.0f, 8.0f);
@@ -133,11 +185,12 @@ void ParticleSystem::emitExplosion(glm::vec3 position, int count) {
             1.0f
         );
         
-        emitParticle(position, velocity, color, randomFloat(0.5f, 1.5f), randomFloat(0.1f, 0.3f));
+        emitParticle(ParticleCategory::Impact, position, velocity, color, randomFloat(0.5f, 1.5f), randomFloat(0.1f, 0.3f));
     }
 }
 
 void ParticleSystem::emitFire(glm::vec3 position, int count) {
+    count = reserve(ParticleCategory::Impact, scaleEmission(ParticleCategory::Impact, position, count));
     for (int i = 0; i < count; ++i) {
         glm::vec3 velocity(
             randomFloat(-0.5f, 0.5f),
@@ -152,11 +205,12 @@ void ParticleSystem::emitFire(glm::vec3 position, int count) {
             1.0f
         );
         
-        emitParticle(position, velocity, color, randomFloat(0.3f, 1.0f), randomFloat(0.1f, 0.2f));
+        emitParticle(ParticleCategory::Impact, position, velocity, color, randomFloat(0.3f, 1.0f), randomFloat(0.1f, 0.2f));
     }
 }
 
 void ParticleSystem::emitSmoke(glm::vec3 position, int count) {
+    count = reserve(ParticleCategory::Smoke, scaleEmission(ParticleCategory::Smoke, position, count));
     for (int i = 0; i < count; ++i) {
         glm::vec3 velocity(
             randomFloat(-0.3f, 0.3f),
@@ -167,14 +221,15 @@ void ParticleSystem::emitSmoke(glm::vec3 position, int count) {
         float gray = randomFloat(0.3f, 0.6f);
         glm::vec4 color = glm::vec4(gray, gray, gray, 0.8f);
         
-        emitParticle(position, velocity, color, randomFloat(1.0f, 2.0f), randomFloat(0.2f, 0.4f));
+        emitParticle(ParticleCategory::Smoke, position, velocity, color, randomFloat(1.0f, 2.0f), randomFloat(0.2f, 0.4f));
     }
 }
 
 void ParticleSystem::emitMuzzleFlash(glm::vec3 position, glm::vec3 forward, int count) {
     glm::vec3 dir = (glm::length2(forward) > 0.0001f) ? glm::normalize(forward) : glm::vec3(0.0f, 0.0f, 1.0f);
 
-    for (int i = 0; i < count; ++i) {
+    int sparkCount = reserve(ParticleCategory::Muzzle, scaleEmission(ParticleCategory::Muzzle, position, count));
+    for (int i = 0; i < sparkCount; ++i) {
         glm::vec3 jitter(
             randomFloat(-0.25f, 0.25f),
             randomFloat(-0.05f, 0.25f),
@@ -189,37 +244,109 @@ void ParticleSystem::emitMuzzleFlash(glm::vec3 position, glm::vec3 forward, int
             1.0f
         );
 
-        emitParticle(position + dir * 0.05f, velocity, color, randomFloat(0.06f, 0.14f), randomFloat(0.08f, 0.14f));
+        emitParticle(ParticleCategory::Muzzle, position + dir * 0.05f, velocity, color, randomFloat(0.06f, 0.14f), randomFloat(0.08f, 0.14f));
     }
 
     // Small trailing smoke puff for added depth (kept minimal for performance)
     int smokeCount = std::max(1, count / 5);
+    smokeCount = reserve(ParticleCategory::Smoke, scaleEmission(ParticleCategory::Smoke, position, smokeCount));
     for (int i = 0; i < smokeCount; ++i) {
         glm::vec3 velocity = dir * randomFloat(1.0f, 3.0f) + glm::vec3(randomFloat(-0.2f, 0.2f), randomFloat(0.2f, 0.6f), randomFloat(-0.2f, 0.2f));
         float gray = randomFloat(0.35f, 0.55f);
         glm::vec4 color = glm::vec4(gray, gray, gray, 0.5f);
-        emitParticle(position, velocity, color, randomFloat(0.25f, 0.45f), randomFloat(0.1f, 0.2f));
+        emitParticle(ParticleCategory::Smoke, position, velocity, color, randomFloat(0.25f, 0.45f), randomFloat(0.1f, 0.2f));
     }
 }
 
-void ParticleSystem::emitParticle(glm::vec3 position, glm::vec3 velocity, 
+int ParticleSystem::scaleEmission(ParticleCategory category, const glm::vec3& position, int count) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    float distance = glm::length(position - viewCenter);
+    float t = glm::clamp((distance - Config::PARTICLE_LOD_NEAR_DISTANCE) /
+                         (Config::PARTICLE_LOD_FAR_DISTANCE - Config::PARTICLE_LOD_NEAR_DISTANCE), 0.0f, 1.0f);
+    float scaled = static_cast<float>(count) * glm::mix(1.0f, Config::PARTICLE_LOD_MIN_SCALE, t);
+
+    // The fractional part becomes a chance of one more, so small bursts keep the right average.
+    // Always keep one so a distant effect does not vanish outright.
+    int result = static_cast<int>(scaled);
+    if (rng.nextFloat() < scaled - static_cast<float>(result)) {
+        result++;
+    }
+    result = glm::clamp(result, 1, count);
+
+    categoryStats[static_cast<int>(category)].culled += static_cast<uint64_t>(count - result);
+    return result;
+}
+
+int ParticleSystem::reserve(ParticleCategory category, int count) {
+    CategoryStats& stats = categoryStats[static_cast<int>(category)];
+    if (count <= 0) {
+        return 0;
+    }
+    if (gpuSimulation) {
+        stats.emitted += static_cast<uint64_t>(count);
+        return count;
+    }
+
+    const CategoryBudget& budget = budgetFor(category);
+    size_t wanted = static_cast<size_t>(count);
+    size_t categoryLimit = static_cast<size_t>(budget.maxParticles);
+    if (wanted > categoryLimit) {
+        stats.dropped += wanted - categoryLimit;
+        wanted = categoryLimit;
+    }
+
+    // Over its own budget, a category recycles its oldest particles rather than refusing new ones
+    size_t current = particles.getCount(category);
+    if (current + wanted > categoryLimit) {
+        stats.evicted += particles.evictOldest(category, current + wanted - categoryLimit);
+    }
+
+    // Pool full: take the oldest particles of the lowest-priority categories first, but never
+    // from a category that outranks the one emitting
+    size_t freeSlots = particles.capacity() - particles.size();
+    for (int pass = 0; wanted > freeSlots && pass <= budget.priority; ++pass) {
+        for (int i = 0; i < static_cast<int>(ParticleCategory::Count) && wanted > freeSlots; ++i) {
+            if (CATEGORY_BUDGETS[i].priority != pass) {
+                continue;
+            }
+            size_t evicted = particles.evictOldest(static_cast<ParticleCategory>(i), wanted - freeSlots);
+            categoryStats[i].evicted += evicted;
+            freeSlots += evicted;
+        }
+    }
+
+    if (wanted > freeSlots) {
+        stats.dropped += wanted - freeSlots;
+        wanted = freeSlots;
+    }
+    stats.emitted += wanted;
+    return static_cast<int>(wanted);
+}
+
+void ParticleSystem::emitParticle(ParticleCategory category, glm::vec3 position, glm::vec3 velocity,
                                    glm::vec4 color, float life, float size) {
-    if (particles.size() < static_cast<size_t>(maxParticles)) {
-        Particle particle;
-        particle.position = position;
-        particle.velocity = velocity;
-        particle.color = color;
-        particle.life = life;
-        particle.initialLife = life;
-        particle.size = size;
-        particle.initialAlpha = color.a;
-        particles.push_back(particle);
+    if (gpuSimulation) {
+        // The ring overwrites its oldest slots instead; only the per-frame request buffer is bounded
+        if (gpuEmitQueue.size() < static_cast<size_t>(maxParticles)) {
+            GpuParticle particle;
+            particle.positionSize = glm::vec4(position, size);
+            particle.velocityLife = glm::vec4(velocity, life);
+            particle.color = color;
+            particle.fade = glm::vec4(1.0f / std::max(life, 0.0001f), color.a, 0.0f, 0.0f);
+            gpuEmitQueue.push_back(particle);
+        }
+        return;
     }
+
+    // A full pool drops new particles
+    particles.add(position, velocity, color, life, size, category);
 }
 
 float ParticleSystem::randomFloat(float min, float max) {
-    std::uniform_real_distribution<float> dist(min, max);
-    return dist(rng);
+    return rng.range(min, max);
 }
 
 // Atmospheric controls
@@ -235,6 +362,159 @@ void ParticleSystem::setAtmosphereRadius(float radius) {
     atmosphereRadius = std::max(0.0f, radius);
 }
 
-const std::vector<Particle>& ParticleSystem::getParticles() const {
-    return particles;
+void ParticleSystem::setAtmosphereProcedural(bool enabled) {
+    if (enabled && !atmosphereShader) {
+        atmosphereShader = std::make_unique<Shader>("shaders/particle_atmosphere.vert", "shaders/particle.frag");
+        if (!atmosphereShader->isLinked()) {
+            std::cout << "[ParticleSystem] Procedural atmosphere shader failed, keeping pooled dust" << std::endl;
+            atmosphereShader.reset();
+            return;
+        }
+    }
+    atmosphereProcedural = enabled;
+}
+
+void ParticleSystem::setAtmosphereMoteCount(int moteCount) {
+    atmosphereMoteCount = std::max(0, moteCount);
+}
+
+bool ParticleSystem::setGpuSimulation(bool enabled) {
+    if (enabled == gpuSimulation) {
+        return true;
+    }
+    if (enabled && !gpuInitialized && !initGpu()) {
+        std::cout << "[ParticleSystem] Compute simulation unavailable, staying on the CPU" << std::endl;
+        return false;
+    }
+
+    gpuSimulation = enabled;
+    particles.clear();
+    gpuEmitQueue.clear();
+    ringHead = 0;
+    ringSlotsUsed = 0;
+    std::cout << "[ParticleSystem] Simulating on the " << (enabled ? "GPU" : "CPU") << std::endl;
+    return true;
+}
+
+bool ParticleSystem::initGpu() {
+    if (maxParticles <= 0) {
+        return false;
+    }
+    // Rendering reads the ring from the vertex shader; GL 4.6 still allows zero storage blocks there
+    int vertexStorageBlocks = 0;
+    glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS, &vertexStorageBlocks);
+    if (vertexStorageBlocks < 1) {
+        return false;
+    }
+
+    emitShader = std::make_unique<Shader>("shaders/particle_emit.comp");
+    updateShader = std::make_unique<Shader>("shaders/particle_update.comp");
+    gpuRenderShader = std::make_unique<Shader>("shaders/particle_gpu.vert", "shaders/particle.frag");
+    if (!emitShader->isLinked() || !updateShader->isLinked() || !gpuRenderShader->isLinked()) {
+        releaseGpu();
+        return false;
+    }
+
+    glGenBuffers(1, &ringSSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ringSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, maxParticles * sizeof(GpuParticle), nullptr, GL_DYNAMIC_COPY);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    // Sized to each frame's requests when they are uploaded
+    glGenBuffers(1, &emitSSBO);
+
+    gpuEmitQueue.reserve(maxParticles);
+    gpuInitialized = true;
+    return true;
+}
+
+void ParticleSystem::releaseGpu() {
+    if (ringSSBO) glDeleteBuffers(1, &ringSSBO);
+    if (emitSSBO) glDeleteBuffers(1, &emitSSBO);
+    ringSSBO = 0;
+    emitSSBO = 0;
+    emitShader.reset();
+    updateShader.reset();
+    gpuRenderShader.reset();
+    gpuInitialized = false;
+}
+
+void ParticleSystem::simulateGpu(float deltaTime) {
+    unsigned int capacity = static_cast<unsigned int>(maxParticles);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ringSSBO);
+
+    unsigned int emitCount = static_cast<unsigned int>(gpuEmitQueue.size());
+    if (emitCount > 0) {
+        // Fresh storage for just this frame's requests, so the upload never waits on last frame's emit pass
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, emitSSBO);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, emitCount * sizeof(GpuParticle), gpuEmitQueue.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, emitSSBO);
+
+        emitShader->use();
+        emitShader->setUInt("emitCount", emitCount);
+        emitShader->setUInt("ringHead", ringHead);
+        emitShader->setUInt("ringCapacity", capacity);
+        glDispatchCompute((emitCount + COMPUTE_GROUP_SIZE - 1) / COMPUTE_GROUP_SIZE, 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+        ringHead = (ringHead + emitCount) % capacity;
+        ringSlotsUsed = std::min(capacity, ringSlotsUsed + emitCount);
+        gpuEmitQueue.clear();
+    }
+
+    if (ringSlotsUsed == 0) {
+        return;
+    }
+
+    updateShader->use();
+    updateShader->setUInt("particleCount", ringSlotsUsed);
+    updateShader->setFloat("deltaTime", deltaTime);
+    updateShader->setFloat("gravity", GRAVITY);
+    glDispatchCompute((ringSlotsUsed + COMPUTE_GROUP_SIZE - 1) / COMPUTE_GROUP_SIZE, 1, 1);
+    // particle_gpu.vert reads the results as shader storage
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void ParticleSystem::drawGpu(const glm::mat4& projection, const glm::mat4& view) {
+    if (ringSlotsUsed == 0) return;
+
+    gpuRenderShader->use();
+    gpuRenderShader->setMat4("projection", projection);
+    gpuRenderShader->setMat4("view", view);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ringSSBO);
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+
+    // Expired slots are culled in the vertex shader
+    glBindVertexArray(VAO);
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, static_cast<GLsizei>(ringSlotsUsed));
+    glBindVertexArray(0);
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_TRUE);
+}
+
+void ParticleSystem::drawAtmosphere(const glm::mat4& projection, const glm::mat4& view) {
+    if (atmosphereMoteCount == 0 || atmosphereRadius <= 0.0f) return;
+
+    atmosphereShader->use();
+    atmosphereShader->setMat4("projection", projection);
+    atmosphereShader->setMat4("view", view);
+    atmosphereShader->setVec3("cameraPosition", viewCenter);
+    atmosphereShader->setFloat("time", atmosphereTime);
+    atmosphereShader->setFloat("radius", atmosphereRadius);
+    atmosphereShader->setFloat("gravity", GRAVITY);
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+
+    // Only the quad corners come from a buffer; everything else is derived from gl_InstanceID
+    glBindVertexArray(VAO);
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, atmosphereMoteCount);
+    glBindVertexArray(0);
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_TRUE);
 }
@@ -0,0 +1,208 @@
+#include "Systems/PathRequestService.h"
+#include "Systems/NavigationGraph.h"
+#include "Config.h"
+#include <chrono>
+#include <utility>
+
+PathRequestService::PathRequestService(int workerCount)
+    : m_graph(nullptr),
+      m_nextTicket(1),
+      m_generation(0),
+      m_inFlight(0),
+      m_stopping(false),
+      m_frameBudgetMs(0.0f),
+      m_frameSpentMs(0.0f),
+      m_mergedCount(0),
+      m_solvedCount(0) {
+    for (int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&PathRequestService::workerLoop, this);
+    }
+}
+
+PathRequestService::~PathRequestService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void PathRequestService::setGraph(const NavigationGraph* graph) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_generation++;
+    m_pending.clear();
+    m_order.clear();
+    m_completed.clear();
+
+    // Workers may still be reading the old graph
+    m_idle.wait(lock, [this] { return m_inFlight == 0; });
+    m_graph = graph;
+}
+
+uint32_t PathRequestService::request(int requesterId, const glm::vec3& start, const glm::vec3& goal,
+                                     RequestType type) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_graph || !m_graph->isValid()) {
+        return 0;
+    }
+    if (type == RequestType::Hierarchical && !m_graph->hasHierarchy()) {
+        type = RequestType::Full;
+    }
+
+    uint32_t ticket = m_nextTicket++;
+    if (m_nextTicket == 0) m_nextTicket = 1;
+
+    int startNode = m_graph->getClosestNode(start);
+    int goalNode = m_graph->getClosestNode(goal);
+
+    // Same node: nothing to search, answer right away (matches NavigationGraph::findPath)
+    if (startNode == goalNode) {
+        m_completed.push_back({requesterId, ticket, {goal}, {}});
+        return ticket;
+    }
+
+    uint64_t key = makeKey(type, startNode, goalNode);
+    auto it = m_pending.find(key);
+    if (it != m_pending.end()) {
+        it->second.waiters.push_back({requesterId, ticket, start, goal});
+        m_mergedCount++;
+        return ticket;
+    }
+
+    Job job;
+    job.type = type;
+    job.startNode = startNode;
+    job.goalNode = goalNode;
+    job.waiters.push_back({requesterId, ticket, start, goal});
+    m_pending.emplace(key, std::move(job));
+    m_order.push_back(key);
+
+    if (!m_workers.empty() && m_frameSpentMs < m_frameBudgetMs) {
+        m_workAvailable.notify_one();
+    }
+    return ticket;
+}
+
+void PathRequestService::update(float budgetMs) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_frameBudgetMs = budgetMs;
+    m_frameSpentMs = 0.0f;
+
+    if (!m_workers.empty()) {
+        lock.unlock();
+        m_workAvailable.notify_all();
+        return;
+    }
+
+    // No workers: spend the slice right here
+    std::vector<PathResult> results;
+    while (canStartJob()) {
+        Job job = std::move(m_pending[m_order.front()]);
+        m_pending.erase(m_order.front());
+        m_order.pop_front();
+
+        auto start = std::chrono::steady_clock::now();
+        solve(m_graph, job, results);
+        m_frameSpentMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        m_solvedCount++;
+    }
+    for (PathResult& result : results) {
+        m_completed.push_back(std::move(result));
+    }
+}
+
+void PathRequestService::takeCompleted(std::vector<PathResult>& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    out.swap(m_completed);
+}
+
+size_t PathRequestService::getQueuedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_order.size();
+}
+
+uint64_t PathRequestService::getMergedRequestCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_mergedCount;
+}
+
+uint64_t PathRequestService::getSolvedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_solvedCount;
+}
+
+void PathRequestService::workerLoop() {
+    std::vector<PathResult> results;
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_workAvailable.wait(lock, [this] { return m_stopping || canStartJob(); });
+        if (m_stopping) {
+            return;
+        }
+
+        uint64_t key = m_order.front();
+        m_order.pop_front();
+        Job job = std::move(m_pending[key]);
+        m_pending.erase(key);
+
+        const NavigationGraph* graph = m_graph;
+        uint32_t generation = m_generation;
+        m_inFlight++;
+        lock.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        results.clear();
+        solve(graph, job, results);
+        float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        lock.lock();
+        m_inFlight--;
+        m_frameSpentMs += elapsedMs;
+        if (generation == m_generation) {
+            for (PathResult& result : results) {
+                m_completed.push_back(std::move(result));
+            }
+            m_solvedCount++;
+        }
+        if (m_inFlight == 0) {
+            m_idle.notify_all();
+        }
+    }
+}
+
+void PathRequestService::solve(const NavigationGraph* graph, Job& job, std::vector<PathResult>& results) const {
+    if (job.type == RequestType::Hierarchical) {
+        // The abstract route only depends on the two nodes and the goal, so merged requesters
+        // share it and each refines its own copy toward its own goal
+        const HierarchicalPathfinder& hierarchy = graph->getHierarchy();
+        HierarchicalPathfinder::Path route;
+        bool found = hierarchy.findPath(job.waiters.front().start, job.waiters.front().goal, route);
+        for (const Waiter& waiter : job.waiters) {
+            PathResult result{waiter.requesterId, waiter.ticket, {}, {}};
+            if (found) {
+                result.abstractPath = route;
+                result.abstractPath.goal = waiter.goal;
+                hierarchy.refine(result.abstractPath, Config::NAV_REFINE_LOOKAHEAD, result.path);
+            }
+            results.push_back(std::move(result));
+        }
+        return;
+    }
+
+    std::vector<int> nodeSequence;
+    bool found = graph->findNodeSequence(job.startNode, job.goalNode, nodeSequence);
+
+    // Every merged requester shares the node search but gets waypoints for its own start and goal
+    for (const Waiter& waiter : job.waiters) {
+        PathResult result{waiter.requesterId, waiter.ticket, {}, {}};
+        if (found) {
+            result.path = graph->buildWaypoints(waiter.start, waiter.goal, nodeSequence);
+        }
+        results.push_back(std::move(result));
+    }
+}
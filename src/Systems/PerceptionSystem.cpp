@@ -0,0 +1,59 @@
+#include "PerceptionSystem.h"
+#include "Entities/Enemy.h"
+#include "Systems/RaycastUtility.h"
+#include "Config.h"
+
+PerceptionSystem::PerceptionSystem()
+    : m_rayCount(0),
+      m_skippedCount(0) {
+}
+
+void PerceptionSystem::update(const std::vector<Enemy>& enemies, const glm::vec3& playerPosition,
+                              const std::vector<Platform>& platforms, const AABBTree* platformTree,
+                              const std::vector<uint8_t>* activeMask) {
+    bool keepPrevious = activeMask && activeMask->size() == enemies.size() &&
+                        m_lineOfSight.size() == enemies.size();
+    if (!keepPrevious) {
+        m_lineOfSight.assign(enemies.size(), 0);
+    }
+    m_rayCount = 0;
+    m_skippedCount = 0;
+
+    m_segments.clear();
+    m_segmentEnemies.clear();
+    glm::vec3 playerEye = playerPosition + glm::vec3(0.0f, Config::EYE_HEIGHT, 0.0f);
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        const Enemy& enemy = enemies[i];
+        if (keepPrevious && !(*activeMask)[i]) {
+            continue;
+        }
+        m_lineOfSight[i] = 0;
+        if (!enemy.isAlive()) {
+            continue;
+        }
+
+        // An idle enemy out of range ignores line of sight entirely this tick
+        float distance = glm::length(playerPosition - enemy.getPosition());
+        if (distance > enemy.getDetectionRange() && !enemy.isTrackingPlayer()) {
+            m_skippedCount++;
+            continue;
+        }
+
+        glm::vec3 enemyEye = enemy.getPosition() + glm::vec3(0.0f, Config::EYE_HEIGHT, 0.0f);
+        m_segments.push_back({enemyEye, playerEye});
+        m_segmentEnemies.push_back(i);
+    }
+
+    // Every segment ends at the player's eye, so they batch into tight packets
+    RaycastUtility::segmentsHitPlatformsBatch(m_segments, m_blocked, platforms, platformTree);
+    for (size_t s = 0; s < m_segments.size(); ++s) {
+        m_lineOfSight[m_segmentEnemies[s]] = m_blocked[s] ? 0 : 1;
+    }
+    m_rayCount = static_cast<int>(m_segments.size());
+}
+
+void PerceptionSystem::clear() {
+    m_lineOfSight.clear();
+    m_rayCount = 0;
+    m_skippedCount = 0;
+}
@@ -2,9 +2,11 @@
 #include "Game.h"
 #include "DebugRenderer.h"
 #include "Config.h"
+#include "RaycastUtility.h"
 #include <iostream>
 
-PhysicsSystem::PhysicsSystem(Game& game) : m_game(game), m_deathTimer(0.0f) {}
+PhysicsSystem::PhysicsSystem(Game& game)
+    : m_game(game), m_deathTimer(0.0f), m_entityGrid(Config::ENTITY_GRID_CELL_SIZE) {}
 
 PhysicsSystem::~PhysicsSystem() {}
 
@@ -26,6 +28,11 @@ void PhysicsSystem::updatePlayerPhysics(float deltaTime) {
     const int SUB_STEPS = 4;
     float subDeltaTime = activeDt / (float)SUB_STEPS;
 
+    // Broadphase: only platforms near this frame's swept box can be touched during the substeps
+    glm::vec3 endPos = playerPos + playerVel * activeDt;
+    glm::vec3 extent = m_game.player.getSize() * 0.5f + glm::vec3(Config::BROADPHASE_MARGIN);
+    m_game.platformTree.queryUserData(glm::min(playerPos, endPos) - extent, glm::max(playerPos, endPos) + extent, m_nearbyPlatforms);
+
     for (int step = 0; step < SUB_STEPS; step++) {
         // 1. Move a small amount
         playerPos += playerVel * subDeltaTime;
@@ -34,8 +41,8 @@ void PhysicsSystem::updatePlayerPhysics(float deltaTime) {
         glm::vec3 preResolutionVel = playerVel;
         bool stepOnPlatform = false;
         
-        for (auto& platform : m_game.platforms) {
-            if (platform.checkCollision(playerPos, m_game.player.getSize(), playerVel)) {
+        for (int index : m_nearbyPlatforms) {
+            if (m_game.platforms[index].checkCollision(playerPos, m_game.player.getSize(), playerVel)) {
                 stepOnPlatform = true;
                 // If we were falling extremely fast (e.g. just spawned and jumped into physics), reset vertical velocity
                 if (playerVel.y < -10.0f) playerVel.y = 0.0f;
@@ -76,7 +83,7 @@ void PhysicsSystem::updatePlayerPhysics(float deltaTime) {
 void PhysicsSystem::updateProjectiles(float deltaTime) {
     for (auto it = m_game.projectiles.begin(); it != m_game.projectiles.end();) {
         if (!it->update(deltaTime)) {
-            it = m_game.projectiles.erase(it);
+            it = m_game.projectiles.despawn(it);
             continue;
         }
         
@@ -88,65 +95,106 @@ void PhysicsSystem::updateProjectiles(float deltaTime) {
     }
 }
 
+void PhysicsSystem::rebuildEntityGrid() {
+    m_entityGrid.clear();
+    for (size_t i = 0; i < m_game.enemies.size(); ++i) {
+        if (m_game.enemies[i].isAlive()) {
+            m_entityGrid.insert(static_cast<int>(i), m_game.enemies[i].getPosition(), Config::PROJECTILE_HIT_RADIUS);
+        }
+    }
+    glm::vec3 playerCenter = m_game.player.getPosition() + glm::vec3(0.0f, m_game.player.getSize().y * 0.5f, 0.0f);
+    m_entityGrid.insert(PLAYER_ENTITY, playerCenter, Config::PROJECTILE_HIT_RADIUS);
+    m_entityGrid.build();
+}
+
 void PhysicsSystem::handleCollisions() {
-    for (auto it = m_game.projectiles.begin(); it != m_game.projectiles.end();) {
+    rebuildEntityGrid();
+
+    // Sweep every projectile's travel this frame against the level in one batch. The nearest
+    // hit is needed (not just any blocker) so a wall in front of an entity stops the shot.
+    m_projectileRays.clear();
+    for (const Projectile& projectile : m_game.projectiles) {
+        glm::vec3 travel = projectile.getPosition() - projectile.getPreviousPosition();
+        float length = glm::length(travel);
+        // Same cut-off as Platform::checkRayCollision; length 0 makes the batch skip the ray
+        if (length < 0.0001f) length = 0.0f;
+        m_projectileRays.push_back({projectile.getPreviousPosition(), travel, length});
+    }
+    RaycastUtility::raycastPlatformsBatch(m_projectileRays, m_projectileLevelHits, m_game.platforms, &m_game.platformTree);
+
+    // Walk backwards: despawning swaps the last (already handled) projectile into the freed
+    // slot, so every index still to be visited keeps matching its batch result
+    for (size_t index = m_game.projectiles.size(); index-- > 0;) {
+        auto it = m_game.projectiles.begin() + index;
         bool hit = false;
         glm::vec3 pPos = it->getPosition();
+        glm::vec3 pPrev = it->getPreviousPosition();
+        bool enemyProjectile = it->isEnemyProjectile();
+
+        // Fraction of this frame's travel at which the level stops the projectile
+        const RaycastUtility::RaycastHit& levelHit = m_projectileLevelHits[index];
+        float levelT = levelHit.hit ? levelHit.distance / m_projectileRays[index].maxDistance : 2.0f;
+
+        // Sweep this frame's travel through the grid and keep the earliest sphere it touches
+        // in front of the level hit
+        int hitEntity = NO_ENTITY;
+        float hitT = levelT;
+        m_entityGrid.querySegment(pPrev, pPos, [&](const SpatialHashGrid::Item& item) {
+            bool isPlayer = (item.userData == PLAYER_ENTITY);
+            if (isPlayer != enemyProjectile) return true;
+            if (!isPlayer && !m_game.enemies[item.userData].isAlive()) return true;
+
+            float t;
+            if (RaycastUtility::segmentSphereIntersection(pPrev, pPos, item.center, item.radius, t) && t < hitT) {
+                hitT = t;
+                hitEntity = item.userData;
+            }
+            return true;
+        });
 
-        if (it->isEnemyProjectile()) {
-            glm::vec3 playerCenter = m_game.player.getPosition() + glm::vec3(0.0f, m_game.player.getSize().y * 0.5f, 0.0f);
-            if (glm::distance(pPos, playerCenter) < 1.0f) {
+        if (enemyProjectile) {
+            if (hitEntity == PLAYER_ENTITY) {
                 m_game.player.takeDamage(it->getDamage(), pPos);
                 if (m_game.hud) m_game.hud->onDamageTaken(m_game.player.getPosition(), m_game.camera.Front, pPos);
                 if (m_game.particleSystem) m_game.particleSystem->emitSmoke(m_game.player.getPosition(), 5);
                 hit = true;
             }
-        } else {
-            for (auto& enemy : m_game.enemies) {
-                if (enemy.isAlive() && glm::distance(pPos, enemy.getPosition()) < 1.0f) {
-                    enemy.takeDamage(it->getDamage());
-                    if (m_game.particleSystem) m_game.particleSystem->emitExplosion(pPos, 2);
-                    
-                    if (!enemy.isAlive()) {
-                        // Drop weapon if not already dropped
-                        if (!enemy.isWeaponDropped() && enemy.getWeapon()) {
-                            m_game.weaponPickups.emplace_back(enemy.getPosition(), enemy.getWeapon()->getType());
-                            enemy.setWeaponDropped(true);
-                        }
-
-                        bool anyOtherAlive = false;
-                        for (const auto& e : m_game.enemies) {
-                            if (&e != &enemy && e.isAlive()) {
-                                anyOtherAlive = true;
-                                break;
-                            }
-                        }
-                        if (anyOtherAlive) {
-                            m_game.triggerBulletTime();
-                        }
-                    }
+        } else if (hitEntity != NO_ENTITY) {
+            Enemy& enemy = m_game.enemies[hitEntity];
+            enemy.takeDamage(it->getDamage());
+            if (m_game.particleSystem) m_game.particleSystem->emitExplosion(pPos, 2);
+
+            if (!enemy.isAlive()) {
+                // Drop weapon if not already dropped
+                if (!enemy.isWeaponDropped() && enemy.getWeapon()) {
+                    m_game.weaponPickups.emplace_back(enemy.getPosition(), enemy.getWeapon()->getType());
+                    enemy.setWeaponDropped(true);
+                }
 
-                    hit = true;
-                    break;
+                bool anyOtherAlive = false;
+                for (const auto& e : m_game.enemies) {
+                    if (&e != &enemy && e.isAlive()) {
+                        anyOtherAlive = true;
+                        break;
+                    }
+                }
+                if (anyOtherAlive) {
+                    m_game.triggerBulletTime();
                 }
             }
+
+            hit = true;
         }
 
-        if (!hit) {
-            for (const auto& platform : m_game.platforms) {
-                if (platform.checkRayCollision(it->getPreviousPosition(), pPos)) {
-                    std::cout << "[Physics] Projectile hit platform! Pos: " << pPos.x << "," << pPos.y << "," << pPos.z << std::endl;
-                    if (m_game.particleSystem) m_game.particleSystem->emitExplosion(pPos, 1);
-                    hit = true;
-                    break;
-                }
-            }
+        if (!hit && levelHit.hit) {
+            glm::vec3 impact = levelHit.point;
+            std::cout << "[Physics] Projectile hit platform! Pos: " << impact.x << "," << impact.y << "," << impact.z << std::endl;
+            if (m_game.particleSystem) m_game.particleSystem->emitExplosion(impact, 1);
+            hit = true;
         }
 
         if (hit) {
-            it = m_game.projectiles.erase(it);
-        } else {
-            ++it;
+            m_game.projectiles.despawn(it);
         }
     }
 
@@ -1,19 +1,179 @@
 #include "Systems/RaycastUtility.h"
 #include "Entities/Platform.h"
+#include "Systems/AABBTree.h"
+#include "Systems/WorkerPool.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <numeric>
+#include <thread>
+
+namespace {
+constexpr int RAY_PACKET_SIZE = 8;
+constexpr float RAY_SORT_CELL_SIZE = 8.0f;     // Origins in the same cell sort next to each other
+constexpr float MAX_PACKET_SPREAD = 2.0f;      // Packet bounds diagonal allowed, relative to its longest ray
+constexpr size_t MAX_SHARED_CANDIDATES = 128; // Wider packets fall back to one tree walk per ray
+constexpr size_t PARALLEL_MIN_RAYS = 512;     // Smaller batches are not worth waking the workers for
+
+// Normalized form shared by both batch queries; length 0 marks a degenerate query
+struct BatchQuery {
+    glm::vec3 origin;
+    glm::vec3 direction;
+    float length;
+};
+
+// Spread the low 20 bits of v so there are two zero bits between each
+uint64_t spreadBits(uint64_t v) {
+    v &= 0xFFFFF;
+    v = (v | (v << 32)) & 0x1F00000000FFFFULL;
+    v = (v | (v << 16)) & 0x1F0000FF0000FFULL;
+    v = (v | (v << 8)) & 0x100F00F00F00F00FULL;
+    v = (v | (v << 4)) & 0x10C30C30C30C30C3ULL;
+    v = (v | (v << 2)) & 0x1249249249249249ULL;
+    return v;
+}
+
+// Direction octant in the top bits, then the Morton code of the origin's cell
+uint64_t sortKey(const BatchQuery& query) {
+    uint64_t octant = (query.direction.x < 0.0f ? 1u : 0u) |
+                      (query.direction.y < 0.0f ? 2u : 0u) |
+                      (query.direction.z < 0.0f ? 4u : 0u);
+    uint64_t morton = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        float cell = std::floor(query.origin[axis] / RAY_SORT_CELL_SIZE) + float(1 << 19);
+        uint64_t clamped = static_cast<uint64_t>(std::clamp(cell, 0.0f, float((1 << 20) - 1)));
+        morton |= spreadBits(clamped) << axis;
+    }
+    return (octant << 60) | morton;
+}
+
+// Started on the first large batch and kept for the rest of the run
+WorkerPool& packetWorkers() {
+    static WorkerPool pool(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())) - 1);
+    return pool;
+}
+
+// Sorts the queries, cuts them into packets and runs the packets on one or more threads.
+// testShared(query, candidates) tests one query against the platforms found for its packet;
+// testAlone(query) is used when a packet's bounds pull in too many platforms.
+template <typename SharedFn, typename AloneFn>
+void runPackets(const std::vector<BatchQuery>& queries, const std::vector<Platform>& platforms,
+                const AABBTree* broadphase, SharedFn&& testShared, AloneFn&& testAlone) {
+    std::vector<uint64_t> keys(queries.size());
+    std::vector<int> order;
+    order.reserve(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (queries[i].length > 0.0f) {
+            keys[i] = sortKey(queries[i]);
+            order.push_back(static_cast<int>(i));
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return keys[a] < keys[b]; });
+
+    size_t packetCount = (order.size() + RAY_PACKET_SIZE - 1) / RAY_PACKET_SIZE;
+    auto runRange = [&](size_t packetBegin, size_t packetEnd) {
+        static thread_local std::vector<int> candidates;
+        candidates.clear();
+        if (!broadphase) {
+            candidates.resize(platforms.size());
+            std::iota(candidates.begin(), candidates.end(), 0);
+        }
+
+        for (size_t packet = packetBegin; packet < packetEnd; ++packet) {
+            size_t first = packet * RAY_PACKET_SIZE;
+            size_t last = std::min(first + RAY_PACKET_SIZE, order.size());
+
+            if (broadphase) {
+                glm::vec3 boundsMin(std::numeric_limits<float>::max());
+                glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+                float longestRay = 0.0f;
+                for (size_t i = first; i < last; ++i) {
+                    const BatchQuery& query = queries[order[i]];
+                    glm::vec3 end = query.origin + query.direction * query.length;
+                    boundsMin = glm::min(boundsMin, glm::min(query.origin, end));
+                    boundsMax = glm::max(boundsMax, glm::max(query.origin, end));
+                    longestRay = std::max(longestRay, query.length);
+                }
+
+                // Rays that do not travel together would only share a much larger box
+                bool coherent = glm::length(boundsMax - boundsMin) <= MAX_PACKET_SPREAD * longestRay;
+                candidates.clear();
+                if (coherent) {
+                    // Stop collecting as soon as the packet is known to be too wide to share
+                    broadphase->query(boundsMin, boundsMax, [&](int index) {
+                        candidates.push_back(index);
+                        return candidates.size() <= MAX_SHARED_CANDIDATES;
+                    });
+                }
+
+                if (!coherent || candidates.size() > MAX_SHARED_CANDIDATES) {
+                    for (size_t i = first; i < last; ++i) {
+                        testAlone(order[i]);
+                    }
+                    continue;
+                }
+            }
+
+            for (size_t i = first; i < last; ++i) {
+                testShared(order[i], candidates);
+            }
+        }
+    };
+
+    WorkerPool& workers = packetWorkers();
+    size_t threadCount = order.size() >= PARALLEL_MIN_RAYS ? std::min(workers.getThreadCount(), packetCount) : 1;
+    if (threadCount <= 1) {
+        runRange(0, packetCount);
+        return;
+    }
+
+    // Contiguous packet ranges keep neighbouring rays on the same thread
+    size_t perThread = (packetCount + threadCount - 1) / threadCount;
+    workers.run(threadCount, [&](size_t t) {
+        size_t begin = std::min(packetCount, t * perThread);
+        size_t end = std::min(packetCount, begin + perThread);
+        if (begin < end) {
+            runRange(begin, end);
+        }
+    });
+}
+
+bool platformEntry(const Platform& platform, const BatchQuery& query, float& tEntry) {
+    float tMax;
+    glm::vec3 halfSize = platform.getSize() * 0.5f;
+    return RaycastUtility::rayAABBIntersection(query.origin, query.direction, platform.getPosition() - halfSize,
+                                               platform.getPosition() + halfSize, tEntry, tMax) &&
+           tEntry <= query.length;
+}
+}
 
 RaycastUtility::RaycastHit RaycastUtility::raycastPlatforms(
     const glm::vec3& origin,
     const glm::vec3& direction,
     float maxDistance,
-    const std::vector<Platform>& platforms
+    const std::vector<Platform>& platforms,
+    const AABBTree* broadphase
 ) {
     RaycastHit result;
     result.hit = false;
     result.distance = maxDistance;
     
     glm::vec3 rayDir = glm::normalize(direction);
+
+    if (broadphase) {
+        broadphase->raycast(origin, rayDir, maxDistance, [&](int i, float clip) {
+            float t = platforms[i].raycast(origin, rayDir, clip);
+            if (t >= 0.0f && t < result.distance) {
+                result.hit = true;
+                result.distance = t;
+                result.point = origin + rayDir * t;
+                result.platformIndex = i;
+                return t;
+            }
+            return clip;
+        });
+        return result;
+    }
     
     for (size_t i = 0; i < platforms.size(); ++i) {
         float t = platforms[i].raycast(origin, rayDir, result.distance);
@@ -31,7 +191,8 @@ RaycastUtility::RaycastHit RaycastUtility::raycastPlatforms(
 bool RaycastUtility::hasLineOfSight(
     const glm::vec3& from,
     const glm::vec3& to,
-    const std::vector<Platform>& platforms
+    const std::vector<Platform>& platforms,
+    const AABBTree* broadphase
 ) {
     glm::vec3 direction = to - from;
     float distance = glm::length(direction);
@@ -40,10 +201,106 @@ bool RaycastUtility::hasLineOfSight(
         return true;
     }
     
-    RaycastHit hit = raycastPlatforms(from, direction, distance, platforms);
+    RaycastHit hit = raycastPlatforms(from, direction, distance, platforms, broadphase);
     return !hit.hit;
 }
 
+void RaycastUtility::raycastPlatformsBatch(
+    const std::vector<Ray>& rays,
+    std::vector<RaycastHit>& outHits,
+    const std::vector<Platform>& platforms,
+    const AABBTree* broadphase
+) {
+    outHits.assign(rays.size(), RaycastHit());
+
+    std::vector<BatchQuery> queries(rays.size());
+    for (size_t i = 0; i < rays.size(); ++i) {
+        float directionLength = glm::length(rays[i].direction);
+        bool valid = directionLength > 0.0f && rays[i].maxDistance > 0.0f && std::isfinite(rays[i].maxDistance);
+        queries[i].origin = rays[i].origin;
+        queries[i].direction = valid ? rays[i].direction / directionLength : glm::vec3(0.0f);
+        queries[i].length = valid ? rays[i].maxDistance : 0.0f;
+        outHits[i].distance = rays[i].maxDistance;
+    }
+
+    auto testShared = [&](int index, const std::vector<int>& candidates) {
+        const BatchQuery& query = queries[index];
+        RaycastHit& hit = outHits[index];
+
+        // Visit candidates in order of entry distance so the nearest hit clips the rest early
+        static thread_local std::vector<std::pair<float, int>> entries;
+        entries.clear();
+        for (int candidate : candidates) {
+            float tEntry;
+            if (platformEntry(platforms[candidate], query, tEntry)) {
+                entries.push_back({tEntry, candidate});
+            }
+        }
+        std::sort(entries.begin(), entries.end());
+
+        for (const auto& [tEntry, candidate] : entries) {
+            if (tEntry >= hit.distance) break;
+            float t = platforms[candidate].raycast(query.origin, query.direction, hit.distance);
+            if (t >= 0.0f && t < hit.distance) {
+                hit.hit = true;
+                hit.distance = t;
+                hit.point = query.origin + query.direction * t;
+                hit.platformIndex = candidate;
+            }
+        }
+    };
+    auto testAlone = [&](int index) {
+        const BatchQuery& query = queries[index];
+        outHits[index] = raycastPlatforms(query.origin, query.direction, query.length, platforms, broadphase);
+    };
+
+    runPackets(queries, platforms, broadphase, testShared, testAlone);
+}
+
+void RaycastUtility::segmentsHitPlatformsBatch(
+    const std::vector<Segment>& segments,
+    std::vector<uint8_t>& outHit,
+    const std::vector<Platform>& platforms,
+    const AABBTree* broadphase
+) {
+    outHit.assign(segments.size(), 0);
+
+    // Same cut-off as Platform::checkRayCollision
+    std::vector<BatchQuery> queries(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        glm::vec3 delta = segments[i].end - segments[i].start;
+        float length = glm::length(delta);
+        bool valid = length >= 0.0001f;
+        queries[i].origin = segments[i].start;
+        queries[i].direction = valid ? delta / length : glm::vec3(0.0f);
+        queries[i].length = valid ? length : 0.0f;
+    }
+
+    auto testShared = [&](int index, const std::vector<int>& candidates) {
+        const BatchQuery& query = queries[index];
+        for (int candidate : candidates) {
+            float tEntry;
+            if (platformEntry(platforms[candidate], query, tEntry) &&
+                platforms[candidate].checkRayCollision(segments[index].start, segments[index].end)) {
+                outHit[index] = 1;
+                return;
+            }
+        }
+    };
+    auto testAlone = [&](int index) {
+        const BatchQuery& query = queries[index];
+        broadphase->raycast(query.origin, query.direction, query.length, [&](int candidate, float clip) {
+            if (platforms[candidate].checkRayCollision(segments[index].start, segments[index].end)) {
+                outHit[index] = 1;
+                return 0.0f;
+            }
+            return clip;
+        });
+    };
+
+    runPackets(queries, platforms, broadphase, testShared, testAlone);
+}
+
 bool RaycastUtility::rayAABBIntersection(
     const glm::vec3& rayOrigin,
     const glm::vec3& rayDir,
@@ -118,3 +375,35 @@ bool RaycastUtility::rayTriangleIntersection(
     if (t > EPSILON) return true;
     else return false;
 }
+
+bool RaycastUtility::segmentSphereIntersection(
+    const glm::vec3& start,
+    const glm::vec3& end,
+    const glm::vec3& center,
+    float radius,
+    float& t
+) {
+    glm::vec3 d = end - start;
+    glm::vec3 m = start - center;
+    float c = glm::dot(m, m) - radius * radius;
+
+    if (c <= 0.0f) {
+        t = 0.0f;
+        return true;
+    }
+
+    float a = glm::dot(d, d);
+    float b = glm::dot(m, d);
+    // Outside and moving away (or not moving at all)
+    if (a < 1e-12f || b > 0.0f) {
+        return false;
+    }
+
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) {
+        return false;
+    }
+
+    t = (-b - std::sqrt(discriminant)) / a;
+    return t <= 1.0f;
+}
@@ -0,0 +1,50 @@
+#include "Systems/SpatialHashGrid.h"
+
+SpatialHashGrid::SpatialHashGrid(float cellSize, int bucketCount)
+    : m_cellSize(cellSize), m_invCellSize(1.0f / cellSize), m_queryStamp(0) {
+    uint32_t buckets = 1;
+    while (buckets < static_cast<uint32_t>(std::max(bucketCount, 1))) buckets <<= 1;
+    m_bucketMask = buckets - 1;
+}
+
+void SpatialHashGrid::clear() {
+    m_items.clear();
+    m_entries.clear();
+    m_bucketStart.clear();
+}
+
+void SpatialHashGrid::insert(int userData, const glm::vec3& center, float radius) {
+    m_items.push_back({center, radius, userData});
+}
+
+void SpatialHashGrid::build() {
+    const uint32_t bucketCount = m_bucketMask + 1;
+    m_bucketStart.assign(bucketCount + 1, 0);
+
+    // Counting sort: first count entries per bucket, then scatter item indices
+    auto forEachCell = [this](const Item& item, auto&& fn) {
+        glm::ivec3 lo = cellOf(item.center - glm::vec3(item.radius));
+        glm::ivec3 hi = cellOf(item.center + glm::vec3(item.radius));
+        for (int x = lo.x; x <= hi.x; ++x)
+            for (int y = lo.y; y <= hi.y; ++y)
+                for (int z = lo.z; z <= hi.z; ++z)
+                    fn(bucketOf(glm::ivec3(x, y, z)));
+    };
+
+    for (const Item& item : m_items) {
+        forEachCell(item, [this](uint32_t bucket) { m_bucketStart[bucket + 1]++; });
+    }
+    for (uint32_t b = 0; b < bucketCount; ++b) {
+        m_bucketStart[b + 1] += m_bucketStart[b];
+    }
+
+    m_entries.resize(m_bucketStart[bucketCount]);
+    std::vector<uint32_t> cursor(m_bucketStart.begin(), m_bucketStart.end() - 1);
+    for (size_t i = 0; i < m_items.size(); ++i) {
+        forEachCell(m_items[i], [&](uint32_t bucket) { m_entries[cursor[bucket]++] = static_cast<int>(i); });
+    }
+
+    // An item spanning several cells can land in the same bucket twice; the visit stamp hides that
+    m_visitStamp.assign(m_items.size(), 0u);
+    m_queryStamp = 0;
+}
@@ -0,0 +1,307 @@
+#include "Systems/TriangleBVH.h"
+#include "Renderer/Mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+void TriangleBVH::build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    std::vector<Triangle> triangles;
+    triangles.reserve(indices.size() / 3);
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        if (indices[i] >= vertices.size() || indices[i+1] >= vertices.size() || indices[i+2] >= vertices.size()) {
+            continue;
+        }
+        triangles.push_back({vertices[indices[i]].Position,
+                             vertices[indices[i+1]].Position,
+                             vertices[indices[i+2]].Position});
+    }
+
+    build(std::move(triangles));
+}
+
+void TriangleBVH::build(std::vector<Triangle> triangles) {
+    m_triangles = std::move(triangles);
+    m_nodes.clear();
+
+    m_packets.clear();
+    m_nodePackets.clear();
+
+    if (m_triangles.empty()) {
+        return;
+    }
+
+    std::vector<glm::vec3> centroids(m_triangles.size());
+    for (size_t i = 0; i < m_triangles.size(); ++i) {
+        centroids[i] = (m_triangles[i].v0 + m_triangles[i].v1 + m_triangles[i].v2) / 3.0f;
+    }
+
+    // A binary tree over n leaves never needs more than 2n - 1 nodes
+    m_nodes.reserve(m_triangles.size() * 2);
+
+    Node root;
+    root.leftFirst = 0;
+    root.count = static_cast<int>(m_triangles.size());
+    updateBounds(root);
+    m_nodes.push_back(root);
+
+    subdivide(0, centroids);
+    m_nodes.shrink_to_fit();
+    buildPackets();
+}
+
+void TriangleBVH::buildPackets() {
+    m_packets.clear();
+    m_nodePackets.assign(m_nodes.size(), 0);
+
+    for (size_t nodeIndex = 0; nodeIndex < m_nodes.size(); ++nodeIndex) {
+        const Node& node = m_nodes[nodeIndex];
+        m_nodePackets[nodeIndex] = static_cast<int>(m_packets.size());
+        for (int first = 0; first < node.count; first += TRIANGLE_PACKET_WIDTH) {
+            TrianglePacket packet;
+            int lanes = std::min(TRIANGLE_PACKET_WIDTH, node.count - first);
+            for (int lane = 0; lane < lanes; ++lane) {
+                const Triangle& tri = m_triangles[node.leftFirst + first + lane];
+                packet.set(lane, tri.v0, tri.v1, tri.v2);
+            }
+            m_packets.push_back(packet);
+        }
+    }
+}
+
+void TriangleBVH::updateBounds(Node& node) const {
+    node.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    node.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+
+    for (int i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+        const Triangle& tri = m_triangles[i];
+        node.boundsMin = glm::min(node.boundsMin, glm::min(tri.v0, glm::min(tri.v1, tri.v2)));
+        node.boundsMax = glm::max(node.boundsMax, glm::max(tri.v0, glm::max(tri.v1, tri.v2)));
+    }
+}
+
+namespace {
+float surfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    glm::vec3 e = boundsMax - boundsMin;
+    return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+}
+
+void TriangleBVH::subdivide(int rootIndex, std::vector<glm::vec3>& centroids) {
+    // Iterative to keep stack depth bounded on degenerate input
+    std::vector<std::pair<int, int>> pending; // (node, depth)
+    pending.push_back({rootIndex, 0});
+
+    while (!pending.empty()) {
+        auto [nodeIndex, depth] = pending.back();
+        pending.pop_back();
+
+        const int first = m_nodes[nodeIndex].leftFirst;
+        const int count = m_nodes[nodeIndex].count;
+        if (count <= MAX_LEAF_TRIANGLES || depth >= MAX_DEPTH) {
+            continue;
+        }
+
+        glm::vec3 centroidMin(std::numeric_limits<float>::max());
+        glm::vec3 centroidMax(std::numeric_limits<float>::lowest());
+        for (int i = first; i < first + count; ++i) {
+            centroidMin = glm::min(centroidMin, centroids[i]);
+            centroidMax = glm::max(centroidMax, centroids[i]);
+        }
+
+        // Binned SAH: pick the axis/plane with the lowest estimated traversal cost
+        int bestAxis = -1;
+        float bestSplit = 0.0f;
+        float bestCost = std::numeric_limits<float>::max();
+
+        for (int axis = 0; axis < 3; ++axis) {
+            float extent = centroidMax[axis] - centroidMin[axis];
+            if (extent <= 0.0f) continue;
+
+            struct Bin {
+                glm::vec3 boundsMin{std::numeric_limits<float>::max()};
+                glm::vec3 boundsMax{std::numeric_limits<float>::lowest()};
+                int count = 0;
+            } bins[SAH_BINS];
+
+            float scale = SAH_BINS / extent;
+            for (int i = first; i < first + count; ++i) {
+                int b = std::min(SAH_BINS - 1, static_cast<int>((centroids[i][axis] - centroidMin[axis]) * scale));
+                const Triangle& tri = m_triangles[i];
+                bins[b].count++;
+                bins[b].boundsMin = glm::min(bins[b].boundsMin, glm::min(tri.v0, glm::min(tri.v1, tri.v2)));
+                bins[b].boundsMax = glm::max(bins[b].boundsMax, glm::max(tri.v0, glm::max(tri.v1, tri.v2)));
+            }
+
+            // Sweep from both sides to get the area/count of each candidate partition
+            float leftArea[SAH_BINS - 1], rightArea[SAH_BINS - 1];
+            int leftCount[SAH_BINS - 1], rightCount[SAH_BINS - 1];
+            glm::vec3 leftMin(std::numeric_limits<float>::max()), leftMax(std::numeric_limits<float>::lowest());
+            glm::vec3 rightMin(std::numeric_limits<float>::max()), rightMax(std::numeric_limits<float>::lowest());
+            int leftSum = 0, rightSum = 0;
+            for (int i = 0; i < SAH_BINS - 1; ++i) {
+                leftSum += bins[i].count;
+                leftCount[i] = leftSum;
+                if (bins[i].count > 0) {
+                    leftMin = glm::min(leftMin, bins[i].boundsMin);
+                    leftMax = glm::max(leftMax, bins[i].boundsMax);
+                }
+                leftArea[i] = leftSum > 0 ? surfaceArea(leftMin, leftMax) : 0.0f;
+
+                int j = SAH_BINS - 1 - i;
+                rightSum += bins[j].count;
+                rightCount[j - 1] = rightSum;
+                if (bins[j].count > 0) {
+                    rightMin = glm::min(rightMin, bins[j].boundsMin);
+                    rightMax = glm::max(rightMax, bins[j].boundsMax);
+                }
+                rightArea[j - 1] = rightSum > 0 ? surfaceArea(rightMin, rightMax) : 0.0f;
+            }
+
+            for (int i = 0; i < SAH_BINS - 1; ++i) {
+                if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+                float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = centroidMin[axis] + (i + 1) / scale;
+                }
+            }
+        }
+
+        // Stop if splitting is not cheaper than testing every triangle in this node
+        Node& node = m_nodes[nodeIndex];
+        float leafCost = count * surfaceArea(node.boundsMin, node.boundsMax);
+        if (bestAxis < 0 || bestCost >= leafCost) {
+            continue;
+        }
+
+        // Partition triangles (and their centroids) in place around the split plane
+        int i = first;
+        int j = first + count - 1;
+        while (i <= j) {
+            if (centroids[i][bestAxis] < bestSplit) {
+                ++i;
+            } else {
+                std::swap(m_triangles[i], m_triangles[j]);
+                std::swap(centroids[i], centroids[j]);
+                --j;
+            }
+        }
+
+        int leftCount = i - first;
+        if (leftCount == 0 || leftCount == count) {
+            continue;
+        }
+
+        int leftIndex = static_cast<int>(m_nodes.size());
+        Node left;
+        left.leftFirst = first;
+        left.count = leftCount;
+        updateBounds(left);
+        Node right;
+        right.leftFirst = i;
+        right.count = count - leftCount;
+        updateBounds(right);
+        m_nodes.push_back(left);
+        m_nodes.push_back(right);
+
+        m_nodes[nodeIndex].leftFirst = leftIndex;
+        m_nodes[nodeIndex].count = 0;
+
+        pending.push_back({leftIndex, depth + 1});
+        pending.push_back({leftIndex + 1, depth + 1});
+    }
+}
+
+namespace {
+// Slab test against precomputed inverse direction; returns entry distance or +inf on miss
+float intersectAABB(const glm::vec3& origin, const glm::vec3& invDir, const glm::vec3& boundsMin, const glm::vec3& boundsMax, float maxT) {
+    float tMin = 0.0f;
+    float tMax = maxT;
+    for (int i = 0; i < 3; ++i) {
+        float t1 = (boundsMin[i] - origin[i]) * invDir[i];
+        float t2 = (boundsMax[i] - origin[i]) * invDir[i];
+        tMin = std::max(tMin, std::min(t1, t2));
+        tMax = std::min(tMax, std::max(t1, t2));
+    }
+    return tMin <= tMax ? tMin : std::numeric_limits<float>::infinity();
+}
+}
+
+bool TriangleBVH::traverse(const glm::vec3& origin, const glm::vec3& direction, float maxT, bool anyHit, float& outT) const {
+    if (m_nodes.empty()) {
+        return false;
+    }
+
+    // Avoid 0 * inf = NaN in the slab test for axis-aligned rays
+    glm::vec3 invDir;
+    for (int i = 0; i < 3; ++i) {
+        float d = direction[i];
+        if (std::abs(d) < 1e-12f) d = (d < 0.0f) ? -1e-12f : 1e-12f;
+        invDir[i] = 1.0f / d;
+    }
+
+    float closestT = maxT;
+    bool hit = false;
+
+    // Depth is capped at build time, so the traversal stack never needs more than MAX_DEPTH + 1 entries
+    int stack[MAX_DEPTH + 1];
+    int stackSize = 0;
+
+    if (intersectAABB(origin, invDir, m_nodes[0].boundsMin, m_nodes[0].boundsMax, closestT) == std::numeric_limits<float>::infinity()) {
+        return false;
+    }
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        int nodeIndex = stack[--stackSize];
+        const Node& node = m_nodes[nodeIndex];
+
+        if (node.count > 0) {
+            int firstPacket = m_nodePackets[nodeIndex];
+            int packetCount = (node.count + TRIANGLE_PACKET_WIDTH - 1) / TRIANGLE_PACKET_WIDTH;
+            for (int i = firstPacket; i < firstPacket + packetCount; ++i) {
+                float t;
+                if (TriangleKernel::intersect(m_packets[i], origin, direction, closestT, t) >= 0) {
+                    closestT = t;
+                    hit = true;
+                    if (anyHit) {
+                        outT = closestT;
+                        return true;
+                    }
+                }
+            }
+            continue;
+        }
+
+        // Visit the nearer child first so later boxes get culled by the shrinking closestT
+        int leftIndex = node.leftFirst;
+        int rightIndex = node.leftFirst + 1;
+        float leftT = intersectAABB(origin, invDir, m_nodes[leftIndex].boundsMin, m_nodes[leftIndex].boundsMax, closestT);
+        float rightT = intersectAABB(origin, invDir, m_nodes[rightIndex].boundsMin, m_nodes[rightIndex].boundsMax, closestT);
+
+        if (leftT > rightT) {
+            std::swap(leftT, rightT);
+            std::swap(leftIndex, rightIndex);
+        }
+
+        if (rightT != std::numeric_limits<float>::infinity()) stack[stackSize++] = rightIndex;
+        if (leftT != std::numeric_limits<float>::infinity()) stack[stackSize++] = leftIndex;
+    }
+
+    if (hit) {
+        outT = closestT;
+    }
+    return hit;
+}
+
+bool TriangleBVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, float& outT) const {
+    return traverse(origin, direction, maxT, false, outT);
+}
+
+bool TriangleBVH::raycastAny(const glm::vec3& origin, const glm::vec3& direction, float maxT) const {
+    float t;
+    return traverse(origin, direction, maxT, true, t);
+}
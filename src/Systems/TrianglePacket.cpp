@@ -0,0 +1,246 @@
+#include "Systems/TrianglePacket.h"
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define TRIANGLE_KERNEL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(TRIANGLE_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TRIANGLE_KERNEL_AVX2 __attribute__((target("avx2")))
+#else
+#define TRIANGLE_KERNEL_AVX2
+#endif
+
+namespace {
+// Same tolerance as RaycastUtility::rayTriangleIntersection
+constexpr float EPSILON = 0.0000001f;
+
+// Picks the nearest of the lanes set in hitMask
+int nearestLane(int hitMask, const float* t, float& outT) {
+    int best = -1;
+    float bestT = std::numeric_limits<float>::infinity();
+    for (int lane = 0; hitMask != 0; ++lane, hitMask >>= 1) {
+        if ((hitMask & 1) && t[lane] < bestT) {
+            bestT = t[lane];
+            best = lane;
+        }
+    }
+    if (best >= 0) {
+        outT = bestT;
+    }
+    return best;
+}
+
+// Lane-by-lane Möller–Trumbore; the operation order matches the glm version exactly
+int intersectScalar(const TrianglePacket& p, const glm::vec3& o, const glm::vec3& d, float maxT, float& outT) {
+    int best = -1;
+    float bestT = maxT;
+    for (int i = 0; i < TRIANGLE_PACKET_WIDTH; ++i) {
+        float hx = d.y * p.e2z[i] - d.z * p.e2y[i];
+        float hy = d.z * p.e2x[i] - d.x * p.e2z[i];
+        float hz = d.x * p.e2y[i] - d.y * p.e2x[i];
+        float a = p.e1x[i] * hx + p.e1y[i] * hy + p.e1z[i] * hz;
+        if (a > -EPSILON && a < EPSILON) continue;
+
+        float f = 1.0f / a;
+        float sx = o.x - p.v0x[i];
+        float sy = o.y - p.v0y[i];
+        float sz = o.z - p.v0z[i];
+        float u = f * (sx * hx + sy * hy + sz * hz);
+        if (u < 0.0f || u > 1.0f) continue;
+
+        float qx = sy * p.e1z[i] - sz * p.e1y[i];
+        float qy = sz * p.e1x[i] - sx * p.e1z[i];
+        float qz = sx * p.e1y[i] - sy * p.e1x[i];
+        float v = f * (d.x * qx + d.y * qy + d.z * qz);
+        if (v < 0.0f || u + v > 1.0f) continue;
+
+        float t = f * (p.e2x[i] * qx + p.e2y[i] * qy + p.e2z[i] * qz);
+        if (t > EPSILON && t <= bestT && (best < 0 || t < bestT)) {
+            bestT = t;
+            best = i;
+        }
+    }
+    if (best >= 0) {
+        outT = bestT;
+    }
+    return best;
+}
+
+#ifdef TRIANGLE_KERNEL_X86
+int intersectSSE2(const TrianglePacket& p, const glm::vec3& o, const glm::vec3& d, float maxT, float& outT) {
+    const __m128 dx = _mm_set1_ps(d.x), dy = _mm_set1_ps(d.y), dz = _mm_set1_ps(d.z);
+    const __m128 ox = _mm_set1_ps(o.x), oy = _mm_set1_ps(o.y), oz = _mm_set1_ps(o.z);
+    const __m128 eps = _mm_set1_ps(EPSILON), negEps = _mm_set1_ps(-EPSILON);
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), limit = _mm_set1_ps(maxT);
+
+    alignas(16) float t[TRIANGLE_PACKET_WIDTH];
+    int hitMask = 0;
+    for (int half = 0; half < TRIANGLE_PACKET_WIDTH; half += 4) {
+        __m128 e1x = _mm_load_ps(p.e1x + half), e1y = _mm_load_ps(p.e1y + half), e1z = _mm_load_ps(p.e1z + half);
+        __m128 e2x = _mm_load_ps(p.e2x + half), e2y = _mm_load_ps(p.e2y + half), e2z = _mm_load_ps(p.e2z + half);
+
+        __m128 hx = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        __m128 hy = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        __m128 hz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, hx), _mm_mul_ps(e1y, hy)), _mm_mul_ps(e1z, hz));
+        __m128 valid = _mm_or_ps(_mm_cmple_ps(a, negEps), _mm_cmpge_ps(a, eps));
+        if (_mm_movemask_ps(valid) == 0) continue;
+
+        __m128 f = _mm_div_ps(one, a);
+        __m128 sx = _mm_sub_ps(ox, _mm_load_ps(p.v0x + half));
+        __m128 sy = _mm_sub_ps(oy, _mm_load_ps(p.v0y + half));
+        __m128 sz = _mm_sub_ps(oz, _mm_load_ps(p.v0z + half));
+        __m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, hx), _mm_mul_ps(sy, hy)), _mm_mul_ps(sz, hz)));
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+        __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        __m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+        __m128 tt = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpgt_ps(tt, eps), _mm_cmple_ps(tt, limit)));
+
+        _mm_store_ps(t + half, tt);
+        hitMask |= _mm_movemask_ps(valid) << half;
+    }
+    return hitMask ? nearestLane(hitMask, t, outT) : -1;
+}
+
+TRIANGLE_KERNEL_AVX2
+int intersectAVX2(const TrianglePacket& p, const glm::vec3& o, const glm::vec3& d, float maxT, float& outT) {
+    const __m256 dx = _mm256_set1_ps(d.x), dy = _mm256_set1_ps(d.y), dz = _mm256_set1_ps(d.z);
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f);
+    const __m256 eps = _mm256_set1_ps(EPSILON);
+
+    __m256 e1x = _mm256_load_ps(p.e1x), e1y = _mm256_load_ps(p.e1y), e1z = _mm256_load_ps(p.e1z);
+    __m256 e2x = _mm256_load_ps(p.e2x), e2y = _mm256_load_ps(p.e2y), e2z = _mm256_load_ps(p.e2z);
+
+    __m256 hx = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+    __m256 hy = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+    __m256 hz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+    __m256 a = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, hx), _mm256_mul_ps(e1y, hy)), _mm256_mul_ps(e1z, hz));
+    __m256 valid = _mm256_or_ps(_mm256_cmp_ps(a, _mm256_set1_ps(-EPSILON), _CMP_LE_OQ), _mm256_cmp_ps(a, eps, _CMP_GE_OQ));
+    if (_mm256_movemask_ps(valid) == 0) return -1;
+
+    __m256 f = _mm256_div_ps(one, a);
+    __m256 sx = _mm256_sub_ps(_mm256_set1_ps(o.x), _mm256_load_ps(p.v0x));
+    __m256 sy = _mm256_sub_ps(_mm256_set1_ps(o.y), _mm256_load_ps(p.v0y));
+    __m256 sz = _mm256_sub_ps(_mm256_set1_ps(o.z), _mm256_load_ps(p.v0z));
+    __m256 u = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, hx), _mm256_mul_ps(sy, hy)), _mm256_mul_ps(sz, hz)));
+    valid = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ)));
+    if (_mm256_movemask_ps(valid) == 0) return -1;
+
+    __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+    __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+    __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+    __m256 v = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)));
+    valid = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ),
+                                               _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ)));
+
+    __m256 t = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)));
+    valid = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(t, eps, _CMP_GT_OQ),
+                                               _mm256_cmp_ps(t, _mm256_set1_ps(maxT), _CMP_LE_OQ)));
+
+    int hitMask = _mm256_movemask_ps(valid);
+    if (hitMask == 0) return -1;
+    alignas(32) float lanes[TRIANGLE_PACKET_WIDTH];
+    _mm256_store_ps(lanes, t);
+    return nearestLane(hitMask, lanes, outT);
+}
+
+bool cpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false; // OS must save YMM state
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+}
+
+TrianglePacket::TrianglePacket() {
+    for (int i = 0; i < TRIANGLE_PACKET_WIDTH; ++i) {
+        v0x[i] = v0y[i] = v0z[i] = 0.0f;
+        e1x[i] = e1y[i] = e1z[i] = 0.0f;
+        e2x[i] = e2y[i] = e2z[i] = 0.0f;
+    }
+}
+
+void TrianglePacket::set(int lane, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) {
+    glm::vec3 e1 = v1 - v0;
+    glm::vec3 e2 = v2 - v0;
+    v0x[lane] = v0.x; v0y[lane] = v0.y; v0z[lane] = v0.z;
+    e1x[lane] = e1.x; e1y[lane] = e1.y; e1z[lane] = e1.z;
+    e2x[lane] = e2.x; e2y[lane] = e2.y; e2z[lane] = e2.z;
+}
+
+std::atomic<TriangleKernel::IntersectFn> TriangleKernel::s_intersect{&TriangleKernel::intersectFirstCall};
+
+TriangleKernel::Level TriangleKernel::getBestSupported() {
+#ifdef TRIANGLE_KERNEL_X86
+    static const Level best = cpuHasAVX2() ? Level::AVX2 : Level::SSE2;
+    return best;
+#else
+    return Level::Scalar;
+#endif
+}
+
+TriangleKernel::Level TriangleKernel::getActive() {
+    IntersectFn current = s_intersect.load(std::memory_order_relaxed);
+    if (current == &intersectFirstCall) {
+        return getBestSupported();
+    }
+#ifdef TRIANGLE_KERNEL_X86
+    if (current == &intersectAVX2) return Level::AVX2;
+    if (current == &intersectSSE2) return Level::SSE2;
+#endif
+    return Level::Scalar;
+}
+
+void TriangleKernel::setActive(Level level) {
+    if (static_cast<int>(level) > static_cast<int>(getBestSupported())) {
+        level = getBestSupported();
+    }
+    s_intersect.store(getKernel(level), std::memory_order_relaxed);
+}
+
+const char* TriangleKernel::getName(Level level) {
+    switch (level) {
+        case Level::AVX2: return "AVX2";
+        case Level::SSE2: return "SSE2";
+        default: return "Scalar";
+    }
+}
+
+TriangleKernel::IntersectFn TriangleKernel::getKernel(Level level) {
+#ifdef TRIANGLE_KERNEL_X86
+    if (level == Level::AVX2) return &intersectAVX2;
+    if (level == Level::SSE2) return &intersectSSE2;
+#else
+    (void)level;
+#endif
+    return &intersectScalar;
+}
+
+int TriangleKernel::intersectFirstCall(const TrianglePacket& packet, const glm::vec3& origin, const glm::vec3& direction,
+                                       float maxT, float& outT) {
+    IntersectFn kernel = getKernel(getBestSupported());
+    s_intersect.store(kernel, std::memory_order_relaxed);
+    return kernel(packet, origin, direction, maxT, outT);
+}
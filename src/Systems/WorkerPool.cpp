@@ -0,0 +1,73 @@
+#include "Systems/WorkerPool.h"
+
+WorkerPool::WorkerPool(int workerCount)
+    : m_task(nullptr),
+      m_taskCount(0),
+      m_nextTask(0),
+      m_unfinished(0),
+      m_stopping(false) {
+    for (int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run(size_t taskCount, const std::function<void(size_t)>& task) {
+    std::unique_lock<std::mutex> runLock(m_runMutex, std::try_to_lock);
+    if (!runLock.owns_lock() || m_workers.empty() || taskCount <= 1) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_taskCount = taskCount;
+    m_nextTask = 0;
+    m_unfinished = taskCount;
+    lock.unlock();
+    m_workAvailable.notify_all();
+
+    // Help out instead of sleeping until the workers are done
+    lock.lock();
+    while (hasTask()) {
+        size_t index = m_nextTask++;
+        lock.unlock();
+        task(index);
+        lock.lock();
+        m_unfinished--;
+    }
+    m_finished.wait(lock, [this] { return m_unfinished == 0; });
+    m_task = nullptr;
+}
+
+void WorkerPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_workAvailable.wait(lock, [this] { return m_stopping || hasTask(); });
+        if (m_stopping) {
+            return;
+        }
+
+        const std::function<void(size_t)>* task = m_task;
+        size_t index = m_nextTask++;
+        lock.unlock();
+        (*task)(index);
+        lock.lock();
+
+        if (--m_unfinished == 0) {
+            m_finished.notify_all();
+        }
+    }
+}
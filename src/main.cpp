@@ -1,12 +1,21 @@
 #include "Game.h"
+#include <cstring>
 
-int main() {
+int main(int argc, char** argv) {
     Game game;
     
     if (!game.initialize()) {
         return -1;
     }
 
+    // --bake-nav: precompute navigation tables for all levels and exit
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bake-nav") == 0) {
+            game.bakeNavigationTables();
+            return 0;
+        }
+    }
+
     game.run();
     return 0;
 }